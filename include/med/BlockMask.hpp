@@ -0,0 +1,65 @@
+#ifndef BLOCK_MASK_HPP
+#define BLOCK_MASK_HPP
+
+#include <cstring>
+
+#include "med/MedTypes.hpp"
+
+/**
+ * Match the values of a block into a mask, one byte per value, for the matchers.
+ * Keep the loop bodies branch-free, so that the compiler can vectorize them.
+ */
+namespace BlockMask {
+  /**
+   * Read the value, which may be unaligned
+   */
+  template<typename T>
+  T readValue(const Byte* address) {
+    T value;
+    memcpy(&value, address, sizeof(T));
+    return value;
+  }
+
+  inline size_t count(const Byte* mask, size_t count) {
+    size_t matched = 0;
+    for (size_t i = 0; i < count; i++) {
+      matched += mask[i];
+    }
+    return matched;
+  }
+
+  /**
+   * @param step bytes between the values
+   * @return number of matched
+   */
+  template<typename T, typename Predicate>
+  size_t fill(const Byte* block, size_t count, size_t step, Byte* mask, Predicate predicate) {
+    for (size_t i = 0; i < count; i++) {
+      mask[i] = predicate(readValue<T>(block + i * step));
+    }
+    return BlockMask::count(mask, count);
+  }
+
+  /**
+   * Match the new values against the old values at the same offsets.
+   */
+  template<typename T, typename Predicate>
+  size_t fill(const Byte* newBlock, const Byte* oldBlock, size_t count, size_t step, Byte* mask, Predicate predicate) {
+    for (size_t i = 0; i < count; i++) {
+      mask[i] = predicate(readValue<T>(newBlock + i * step), readValue<T>(oldBlock + i * step));
+    }
+    return BlockMask::count(mask, count);
+  }
+
+  /**
+   * Keep only the matched in the mask, for the combined predicates.
+   */
+  template<typename T, typename Predicate>
+  void andWith(const Byte* block, size_t count, size_t step, Byte* mask, Predicate predicate) {
+    for (size_t i = 0; i < count; i++) {
+      mask[i] &= predicate(readValue<T>(block + i * step));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef DELTA_MATCHER_HPP
+#define DELTA_MATCHER_HPP
+
+#include <string>
+#include "med/MedTypes.hpp"
+
+using namespace std;
+
+/**
+ * Compare the new value with the remembered (old) value by the difference.
+ * "+= 5" increased by 5, "-= 2 10" decreased by 2 to 10, "%< 10" changed by less than 10%.
+ * Integers are subtracted with wrap around, so that 250 to 4 (int8) is increased by 10.
+ */
+class DeltaMatcher {
+public:
+  DeltaMatcher(const string& value, const string& scanType);
+
+  bool match(const Byte* newValue, const Byte* oldValue) const;
+
+  /**
+   * Match "count" values of the new block against the old block, each value is "step" bytes apart.
+   * Write 1 (matched) or 0 to the mask.
+   * @return number of matched values
+   */
+  size_t matchBlock(const Byte* newBlock, const Byte* oldBlock, size_t count, size_t step, Byte* mask) const;
+
+  ScanType getScanType();
+  size_t getSize();
+
+private:
+  template<typename T>
+  size_t matchBlockOf(const Byte* newBlock, const Byte* oldBlock, size_t count, size_t step, Byte* mask) const;
+
+  ScanType scanType;
+  ScanParser::OpType op;
+  double low;
+  double high;
+};
+
+#endif
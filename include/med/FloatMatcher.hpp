@@ -0,0 +1,51 @@
+#ifndef FLOAT_MATCHER_HPP
+#define FLOAT_MATCHER_HPP
+
+#include <cstdint>
+#include "med/MedTypes.hpp"
+#include "med/Operands.hpp"
+
+using namespace std;
+
+/**
+ * Compare float32 and float64 by value instead of bytes.
+ * The operands are decoded once, so that the scan and filter loops
+ * only do the arithmetic.
+ */
+class FloatMatcher {
+public:
+  FloatMatcher();
+  FloatMatcher(ScanType scanType, Operands& operands, const ScanParser::OpType& op);
+
+  bool match(const Byte* address) const;
+
+  /**
+   * Match "count" values in the block, each value is "step" bytes apart.
+   * Write 1 (matched) or 0 to the mask.
+   * @return number of matched values
+   */
+  size_t matchBlock(const Byte* block, size_t count, size_t step, Byte* mask) const;
+
+  static bool isFloatType(ScanType scanType);
+
+  /**
+   * Distance in units in the last place, i.e. number of representable values in between.
+   */
+  static int64_t ulpDistance(float a, float b);
+  static int64_t ulpDistance(double a, double b);
+
+private:
+  template<typename T>
+  bool matchValue(T value) const;
+
+  template<typename T>
+  size_t matchBlockOf(const Byte* block, size_t count, size_t step, Byte* mask) const;
+
+  ScanType scanType;
+  ScanParser::OpType op;
+  double first;
+  double second;
+  int64_t ulps;
+};
+
+#endif
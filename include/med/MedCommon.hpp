@@ -42,8 +42,36 @@ void printHex(FILE* file, void* addr, int size);
 
 /**
  * @param pid is pid_t, which is actually integer.
+ * @param writableOnly only the writable maps, for scanning. Otherwise all the readable maps.
  */
-Maps getMaps(pid_t pid);
+Maps getMaps(pid_t pid, bool writableOnly = true);
+
+/**
+ * Mapped file of the process. "start" is the lowest address the file is mapped at.
+ */
+struct Module {
+  string name;
+  Address start;
+  Address end;
+};
+
+/**
+ * Modules from the content of /proc/[pid]/maps, the mappings of the same file are merged.
+ */
+vector<Module> parseModules(const string& maps);
+vector<Module> getModules(pid_t pid);
+
+/**
+ * Move the address in a module to the same offset of the module of the same path, such as after the process restarts.
+ * The address is unchanged if it is not in a module, or the module is not found.
+ * @param relocated is set to whether the address is moved
+ */
+Address relocateAddress(Address address, const vector<Module>& from, const vector<Module>& to, bool* relocated = NULL);
+
+/**
+ * Describe the address as "libname.so+0x1234", or as hex address if no module contains it.
+ */
+string addressToModuleOffset(const vector<Module>& modules, Address address);
 
 /**
  * Convert the size to padded word size.
@@ -68,8 +96,6 @@ int pidStop(pid_t pid);
  */
 string pidName(const string& pid);
 
-vector<Process> pidList();
-
 /**
  * This will just perform the unlock by force
  */
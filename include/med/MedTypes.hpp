@@ -61,6 +61,12 @@ namespace ScanParser {
     Le,
     Within,
     Around,
+    AroundUlp,
+    Rounded,
+    Truncated,
+    IncreasedBy,
+    DecreasedBy,
+    ChangedByPercent,
     SnapshotSave
   };
 };
@@ -11,8 +11,8 @@ public:
   explicit Operands(std::vector<SizedBytes> l);
   size_t count();
 
-  SizedBytes getFirstOperand();
-  SizedBytes getSecondOperand();
+  SizedBytes& getFirstOperand();
+  SizedBytes& getSecondOperand();
 
   size_t getFirstSize();
 private:
@@ -2,6 +2,7 @@
 #define PROCESS_HPP
 
 #include <string>
+#include <sys/types.h>
 #include <vector>
 
 #include "med/MedTypes.hpp"
@@ -14,6 +15,12 @@ public:
 
   string pid;
   string cmdline; //aka "process" in GUI
+
+  pid_t ppid = 0;
+  string comm; // Name from /proc/[pid]/stat, up to 15 characters
+  string exe; // Target of /proc/[pid]/exe, empty if not permitted
+  unsigned long long startTime = 0; // Clock ticks after boot, tells a reused pid apart
+  size_t rss = 0; // Resident bytes
 };
 
 #endif
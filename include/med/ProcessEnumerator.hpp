@@ -0,0 +1,56 @@
+#ifndef PROCESS_ENUMERATOR_HPP
+#define PROCESS_ENUMERATOR_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "med/Process.hpp"
+
+using namespace std;
+
+/**
+ * List the processes from /proc, caching each process by its pid and start time.
+ * A refresh reads only /proc/[pid]/stat of the known processes, for the RSS;
+ * the cmdline and the exe are read once, when the process is first seen.
+ */
+class ProcessEnumerator {
+public:
+  /**
+   * Re-read /proc, the exited processes are dropped
+   */
+  void refresh();
+
+  /**
+   * Processes with a cmdline, by the order of the pids.
+   * The kernel threads have no cmdline.
+   */
+  vector<Process> getProcesses();
+
+  /**
+   * Processes of which the comm, the cmdline, or the exe contains the name (case insensitive),
+   * and with at least minRss bytes resident
+   */
+  vector<Process> filter(const string& name, size_t minRss = 0);
+
+  /**
+   * Processes by descending RSS, up to count
+   */
+  vector<Process> getLargest(size_t count, const string& name = "");
+
+  /**
+   * The process and all its descendants, by the parent pids of the last refresh
+   */
+  vector<pid_t> getTree(pid_t root);
+
+  /**
+   * Parse the content of /proc/[pid]/stat into the process, the comm may contain spaces and parentheses.
+   * @return false if malformed
+   */
+  static bool parseStat(const string& stat, Process& process);
+
+private:
+  map<pid_t, Process> cache;
+};
+
+#endif
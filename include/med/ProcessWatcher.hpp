@@ -0,0 +1,82 @@
+#ifndef PROCESS_WATCHER_HPP
+#define PROCESS_WATCHER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "med/MedCommon.hpp"
+#include "med/Process.hpp"
+#include "med/ProcessEnumerator.hpp"
+
+using namespace std;
+
+/**
+ * Watch the process for exit, then wait for its new instance, by the same exe, or the same cmdline if
+ * the exe is unknown. The exit is detected by a pidfd where available, otherwise by the start time in
+ * /proc/[pid]/stat, so a reused pid is not mistaken for the process.
+ * The new instance must start after the exit, so another running instance is not taken.
+ * The modules of the process are kept, because its maps are gone once it exits.
+ * The restart is taken by the owner, which re-attaches from its own thread.
+ */
+class ProcessWatcher {
+public:
+  ProcessWatcher();
+  ~ProcessWatcher();
+
+  /**
+   * Watch the process, replacing the watched one. The process requires the start time, exe and cmdline,
+   * as listed by the ProcessEnumerator.
+   */
+  void watch(const Process& process);
+  void stop();
+
+  bool isExited();
+
+  /**
+   * Take the new instance once, after it has settled.
+   * @param modules are the modules of the exited instance
+   * @return false if not restarted
+   */
+  bool takeRestart(Process& process, vector<Module>& modules);
+
+  /**
+   * Whether the candidate is a new instance of the process, started after it
+   */
+  static bool isNewInstance(const Process& process, const Process& candidate);
+
+  static const int WATCH_INTERVAL = 500; // ms
+  static const int MODULE_REFRESH_INTERVAL = 5000; // ms
+  static const int RESTART_SETTLE_TIME = 2000; // ms, for the new instance to load its modules
+
+private:
+  typedef chrono::steady_clock Clock;
+
+  void run();
+  bool hasExited();
+  static unsigned long long ticksAfterBoot(); // In the clock ticks of the start time
+  void openPidfd();
+  void closePidfd();
+
+  Process process;
+  vector<Module> modules;
+  Clock::time_point modulesTime;
+  int pidfd;
+  bool exited;
+  unsigned long long exitTime; // Clock ticks after boot, the new instance starts after it
+
+  Process newProcess;
+  Clock::time_point foundTime;
+  bool restarted;
+  vector<Module> oldModules;
+
+  ProcessEnumerator enumerator;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::thread* thread;
+  bool running;
+};
+
+#endif
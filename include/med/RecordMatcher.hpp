@@ -0,0 +1,69 @@
+#ifndef RECORD_MATCHER_HPP
+#define RECORD_MATCHER_HPP
+
+#include <string>
+#include <vector>
+#include "med/MedTypes.hpp"
+
+using namespace std;
+
+/**
+ * Match the fields of the records of an array, each record is "stride" bytes apart.
+ * The predicates are separated by ";", each is "offset type condition", such as
+ * "0x0 int32 <> 1 999; 0x8 float32 > 0". The condition is one of "=", "!", ">", "<", ">=", "<=", and "<>".
+ * A record matches if all the predicates hold.
+ */
+class RecordMatcher {
+public:
+  RecordMatcher(const string& predicates, size_t stride, size_t minRecords);
+
+  /**
+   * Match the records starting at every "step" bytes of the block, for "count" records.
+   * The block must have (count - 1) * step + getSpan() bytes.
+   * Write 1 (matched) or 0 to the mask.
+   * @return number of matched records
+   */
+  size_t matchBlock(const Byte* block, size_t count, size_t step, Byte* mask) const;
+
+  bool match(const Byte* record) const;
+
+  size_t getStride();
+  size_t getMinRecords();
+
+  /**
+   * Bytes of a record that are read by the predicates
+   */
+  size_t getSpan();
+
+  /**
+   * Alignment of the record starts, the largest power of 2 dividing the stride, up to 4
+   */
+  size_t getAlignment();
+
+  /**
+   * Type of the field at offset 0, for the results, which are the record starts.
+   * int8 if no predicate is at offset 0, so that the value never exceeds the record.
+   */
+  string getScanType();
+
+private:
+  struct Predicate {
+    size_t offset;
+    ScanType scanType;
+    ScanParser::OpType op;
+    double low;
+    double high;
+  };
+
+  void andPredicate(const Predicate& predicate, const Byte* block, size_t count, size_t step, Byte* mask) const;
+
+  template<typename T>
+  void andPredicateOf(const Predicate& predicate, const Byte* block, size_t count, size_t step, Byte* mask) const;
+
+  vector<Predicate> predicates;
+  size_t stride;
+  size_t minRecords;
+  size_t span;
+};
+
+#endif
@@ -15,6 +15,13 @@ public:
   size_t getSize();
 
   bool match(Byte* address);
+
+  /**
+   * Match "count" positions of the block, each is "step" bytes apart.
+   * Write 1 (matched) or 0 to the mask.
+   * @return number of matched positions
+   */
+  size_t matchBlock(Byte* block, size_t count, size_t step, Byte* mask);
   string getFirstScanType();
 private:
   vector<SubCommand> subCommands;
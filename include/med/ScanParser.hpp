@@ -16,7 +16,7 @@
 using namespace std;
 
 namespace ScanParser {
-  constexpr const char* OP_REGEX = "^(=|>(?=[^=])|<(?=[^=>])|>=|<=|!|<>|\\?|<|>|~)";
+  constexpr const char* OP_REGEX = "^(=|>(?=[^=])|<(?=[^=>])|>=|<=|!|<>|\\?|<|>|~u|~r|~t|~|\\+=|-=|%<)";
   string getOp(const string &v);
   OpType stringToOpType(const string &s); /** Convert a string (or character) to OpType */
   OpType getOpType(const string &v); /** Get OpType from a string */
@@ -27,6 +27,7 @@ namespace ScanParser {
 
   bool isValid(const string &v);
   bool isSnapshotOperator(const OpType& opType);
+  bool isDeltaOperator(const OpType& opType); /** Compare with the remembered value by difference */
 
   SizedBytes valueToBytes(const string& v, const string& t);
 
@@ -39,6 +40,7 @@ namespace ScanParser {
   // If the input is an array (with commas), it is one operand.
   Operands valueToOperands(const string& v, const string& t, OpType op = OpType::Eq);
   Operands getTwoOperands(const string& v, const string& t, OpType op = OpType::Within);
+  Operands getUlpOperands(const string& v, const string& t); /** Value and number of ULPs (int64, default 1) */
 
   ScanCommand getScanCommand(const string& v, const string& scanType = SCAN_TYPE_CUSTOM);
 
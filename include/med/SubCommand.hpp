@@ -5,6 +5,7 @@
 #include <tuple>
 #include "med/MedTypes.hpp"
 #include "med/Operands.hpp"
+#include "med/FloatMatcher.hpp"
 
 using namespace std;
 
@@ -35,6 +36,9 @@ public:
    */
   tuple<bool, int> match(Byte* address);
 
+  bool isFloat(); /** float32 or float64, which is matched by value */
+  FloatMatcher& getFloatMatcher();
+
   ScanParser::OpType op;
 
   static Command parseCmd(const string &s);
@@ -46,6 +50,8 @@ private:
   Operands operands;
   Command cmd;
   int wildcardSteps;
+  bool hasFloatMatcher;
+  FloatMatcher floatMatcher;
 };
 
 #endif
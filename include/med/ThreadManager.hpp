@@ -19,6 +19,7 @@ public:
   void start();
 
   void setMaxThreads(int num);
+  int getMaxThreads();
 
 private:
   std::vector<TMTask*> container;
@@ -0,0 +1,92 @@
+#ifndef CHANGE_PROFILER_HPP
+#define CHANGE_PROFILER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+const size_t CACHE_LINE_SIZE = 64;
+const int DEFAULT_PROFILE_INTERVAL = 200; // ms
+const size_t DEFAULT_PROFILE_SLICE_SIZE = 64 * 1024 * 1024; // Bytes sampled per interval
+const double DEFAULT_VOLATILE_RATE = 0.5;
+
+struct PageHeat {
+  Address address;
+  size_t samples;
+  size_t changes;
+  double rate; // changes per sample, after the first sample
+  vector<uint32_t> lineChanges; // By cache line, empty until the page changes
+};
+
+/**
+ * Sample the memory periodically, and count how often each page changes.
+ * Each page keeps only the hash of its content, so that an unchanged page costs a hash.
+ * After a page changes, the hashes of its cache lines are kept too, then the changed lines are counted.
+ *
+ * Without regions, all the rw maps of the process are sampled, "slice size" bytes per interval,
+ * so that a large heap is covered by several intervals.
+ */
+class ChangeProfiler {
+public:
+  explicit ChangeProfiler(MemIO* memio);
+  ~ChangeProfiler();
+
+  void setRegions(const AddressPairs& regions);
+  void setInterval(int ms);
+  int getInterval();
+  void setSliceSize(size_t size);
+
+  void start();
+  void stop();
+  bool isRunning();
+
+  /**
+   * Sample the next slice, called by the profiler thread on each interval.
+   */
+  void sample();
+  void clear();
+
+  vector<PageHeat> getHeatMap();
+
+  /**
+   * Merged ranges of the pages that change at least "minRate" of the samples.
+   */
+  AddressPairs getVolatileRanges(double minRate = DEFAULT_VOLATILE_RATE);
+
+private:
+  struct PageState {
+    uint64_t hash;
+    uint32_t samples;
+    uint32_t changes;
+    vector<uint32_t> lineHashes;
+    vector<uint32_t> lineChanges;
+  };
+
+  void run();
+  AddressPairs getSampleRegions();
+  void samplePage(Address address, const Byte* page, size_t pageSize);
+
+  MemIO* memio;
+  AddressPairs regions;
+  AddressPairs passRegions; // Regions of the current pass, refreshed when a pass completes
+  Address cursor;
+  int interval;
+  size_t sliceSize;
+  map<Address, PageState> pages;
+  std::mutex mutex; // Guards the pages and the settings
+  std::mutex sampleMutex;
+
+  std::thread* thread;
+  std::condition_variable cv;
+  bool running;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef FREEZER_HPP
+#define FREEZER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "mem/MemIO.hpp"
+#include "mem/Sem.hpp"
+
+using namespace std;
+
+/**
+ * Write the locked values by their own interval.
+ * Entries are kept in a priority queue by the due time, so that each wake up
+ * only writes the due entries, in one batch. Sleep until the next due time,
+ * or until an entry is added if nothing is locked.
+ *
+ * If write only if changed, the due values are read in batch first,
+ * and only the changed values are written back.
+ */
+class Freezer {
+public:
+  explicit Freezer(MemIO* memio);
+  ~Freezer();
+
+  /**
+   * Schedule the locked value. Schedule again after its interval is changed.
+   * Unlocked or removed entry is dropped when it is due.
+   */
+  void add(SemPtr sem);
+  void clear();
+  size_t size();
+
+  void start();
+  void stop();
+
+  void setWriteOnlyIfChanged(bool value);
+  bool getWriteOnlyIfChanged();
+
+  /**
+   * Write the values at once by the calling thread, out of their schedule.
+   * This is the same write as by the interval, each process in its own batch.
+   */
+  void writeNow(const vector<SemPtr>& sems);
+
+private:
+  typedef chrono::steady_clock Clock;
+
+  struct Entry {
+    Clock::time_point due;
+    weak_ptr<Sem> sem;
+    Sem* key; // Only for the generations, never dereferenced
+    uint64_t generation;
+
+    bool operator>(const Entry& other) const {
+      return due > other.due;
+    }
+  };
+
+  void run();
+  void write(MemIO* memio, vector<SemPtr>& sems);
+
+  MemIO* memio;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+  map<Sem*, uint64_t> generations; // Latest schedule of each entry, older entries are dropped
+  uint64_t nextGeneration;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::thread* thread;
+  bool running;
+  std::atomic<bool> writeOnlyIfChanged;
+};
+
+#endif
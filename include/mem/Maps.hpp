@@ -17,7 +17,27 @@ public:
   bool hasPair(const AddressPair& pair);
   void push(const AddressPair& pair);
   void trimByScope(const AddressPair& scope);
+
+  /**
+   * Remove the ranges from the maps, a pair is split if the range is inside it.
+   */
+  void exclude(const AddressPairs& ranges);
   size_t size();
+
+  /**
+   * Sort the pairs by address, so that contains() can search them
+   */
+  void sort();
+
+  /**
+   * Whether the address is in any pair, by binary search. The pairs must be sorted.
+   */
+  bool contains(Address address);
+
+  /**
+   * Total bytes of all the pairs
+   */
+  size_t getTotalSize();
   void clear();
 
 private:
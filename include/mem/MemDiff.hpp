@@ -0,0 +1,74 @@
+#ifndef MEM_DIFF_HPP
+#define MEM_DIFF_HPP
+
+#include <string>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+/**
+ * Copy of a region. Pages that cannot be read are zero and not readable.
+ */
+struct MemSnapshot {
+  Address address;
+  vector<Byte> data;
+  vector<bool> readable; // By page
+
+  bool isReadable(size_t offset) const;
+};
+
+struct DiffRange {
+  Address address;
+  size_t size;
+};
+
+struct DiffValue {
+  Address address;
+  string before;
+  string after;
+};
+
+/**
+ * Compare the snapshots of a region, or a snapshot with the live memory, such as finding the layout of a struct.
+ * The changed bytes are coalesced into ranges, instead of a record for each byte.
+ */
+class MemDiff {
+public:
+  explicit MemDiff(MemIO* memio);
+
+  MemSnapshot take(Address address, size_t size);
+
+  /**
+   * Changes from "before" to "after", which must be of the same region.
+   * @param gap changes separated by at most "gap" unchanged bytes are in the same range
+   */
+  vector<DiffRange> compare(const MemSnapshot& before, const MemSnapshot& after, size_t gap = 0);
+
+  /**
+   * Take the snapshot of the same region into "after", then compare
+   */
+  vector<DiffRange> compareLive(const MemSnapshot& before, MemSnapshot& after, size_t gap = 0);
+
+  /**
+   * Compare the buffers word by word, skipping the equal blocks by memcmp
+   */
+  static vector<DiffRange> diff(Address base, const Byte* before, const Byte* after, size_t size, size_t gap = 0);
+
+  /**
+   * Values of the range, by the scan type aligned to its size, so that a changed field shows as a whole
+   */
+  static vector<DiffValue> interpret(const MemSnapshot& before,
+                                     const MemSnapshot& after,
+                                     const DiffRange& range,
+                                     const string& scanType);
+
+  static const size_t PAGE_SIZE = 4096;
+
+private:
+  MemIO* memio;
+};
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef MEM_ED_HPP
 #define MEM_ED_HPP
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -9,9 +12,11 @@
 #include "mem/MemScanner.hpp"
 #include "mem/MemList.hpp"
 #include "mem/NamedScans.hpp"
+#include "mem/Freezer.hpp"
+#include "mem/ChangeProfiler.hpp"
 #include "med/Process.hpp"
-
-const int LOCK_REFRESH_RATE = 800;
+#include "med/ProcessEnumerator.hpp"
+#include "med/ProcessWatcher.hpp"
 
 class MemEd {
 public:
@@ -20,8 +25,43 @@ public:
   ~MemEd();
   void setPid(pid_t pid);
   pid_t getPid();
+
+  /**
+   * Scan and filter other processes together with the selected process, such as the render and
+   * the logic processes of a game. The processes run in parallel, each with a fair share of the threads.
+   * The results and the store entries read their own process by their MemIO.
+   * Selecting a process by setPid() ends the session.
+   */
+  void setSessionPids(const vector<pid_t>& pids);
+
+  /**
+   * Add the descendants of the selected process to the session
+   */
+  void addProcessTree();
+
+  /**
+   * Selected process first
+   */
+  vector<pid_t> getSessionPids();
+  MemIO* getMemIO(pid_t pid); // NULL if not in the session
   vector<MemPtr> scan(const string& value, const string& scanType, bool fastScan = false, const string& lastDigit = "");
   vector<MemPtr> filter(const string& value, const string& scanType, bool fastScan = false);
+
+  /**
+   * Scan or filter in the background, the scan list is set when finished, including when cancelled.
+   * Only one runs at a time, starting another waits for the previous one.
+   */
+  ScanProgressPtr scanAsync(const string& value, const string& scanType, bool fastScan = false, const string& lastDigit = "");
+  ScanProgressPtr filterAsync(const string& value, const string& scanType, bool fastScan = false);
+
+  /**
+   * Scan the arrays of the records matching the predicates, see RecordMatcher
+   */
+  vector<MemPtr> scanRecords(const string& predicates, size_t stride, size_t minRecords);
+  ScanProgressPtr scanRecordsAsync(const string& predicates, size_t stride, size_t minRecords);
+  bool isScanning();
+  void cancelScan();
+
   NamedScans& getNamedScans();
   MemList getScans();
   void clearScans();
@@ -29,18 +69,55 @@ public:
   void addToStoreByIndex(int index);
   void addNewAddress();
   MemPtr readMemory(Address addr, size_t size);
+  MemIO* getMemIO();
+  ScanStats getScanStats();
   void setValueByAddress(Address addr, const string& value, const string& scanType);
 
   // Process
-  vector<Process> listProcesses();
+  /**
+   * Refresh the processes incrementally, keeping those matched by the name and the minimum RSS (bytes)
+   */
+  vector<Process> listProcesses(const string& name = "", size_t minRss = 0);
+  void refreshProcesses();
+
+  /**
+   * Filter the processes of the last refresh, without reading /proc
+   */
+  vector<Process> filterProcesses(const string& name = "", size_t minRss = 0);
   Process selectProcessByIndex(int index);
+  Process selectProcess(const string& pid);
+
+  /**
+   * Select the process with the largest RSS, matched by the name
+   * @return empty pid if no process is matched
+   */
+  Process selectLargestProcess(const string& name);
+
+  /**
+   * Re-attach to the new instance if the selected process has restarted, to be called periodically.
+   * The store entries in the modules are moved to the same offsets of the new instance, and frozen again.
+   * The other entries are unlocked, because their addresses hold unrelated data in the new instance.
+   * The other processes of the session are kept, if they are still running.
+   * @param numOfUnlocked is set to the number of the entries unlocked
+   * @return true if re-attached
+   */
+  bool reattachIfRestarted(size_t* numOfUnlocked = NULL);
+  bool isProcessExited();
   vector<Process> processes;
   Process selectedProcess;
 
   void lockValues();
   bool hasLockValue();
+  void setLocked(SemPtr sem, bool value);
+  void setLockInterval(SemPtr sem, int ms);
+  void setWriteOnlyIfChanged(bool value);
 
-  static void callLockValues(MemEd* med);
+  ChangeProfiler* getChangeProfiler();
+
+  /**
+   * Skip the volatile ranges of the change profiler when scanning
+   */
+  void setSkipVolatile(bool value);
 
   void saveFile(const char* filename);
   void openFile(const char* filename);
@@ -63,14 +140,37 @@ public:
 
 private:
   void initialize();
+  ScanProgressPtr startAsync(std::function<vector<MemPtr>()> fn);
+  void waitAsync();
+  vector<MemScanner*> getScanners();
+  map<MemScanner*, vector<MemPtr>> partition(const vector<MemPtr>& list);
+
+  /**
+   * Run on all the scanners in parallel, and join the results by the order of the scanners.
+   * Fails only if all the scanners fail, such as a process of the session has exited.
+   */
+  vector<MemPtr> forEachScanner(std::function<vector<MemPtr>(MemScanner*)> fn);
+
   pid_t pid;
   MemScanner* scanner;
+  // All the scanners ever in the session, one per pid. They are never repointed nor deleted until the end,
+  // because the results and the store entries of a process that left the session still hold its MemIO.
+  vector<MemScanner*> sessionScanners;
+  vector<MemScanner*> activeScanners; // Of the current session processes
+
+  ProcessEnumerator processEnumerator;
+  ProcessWatcher processWatcher;
   NamedScans namedScans;
   MemList* store;
   std::mutex storeMutex;
-  std::thread* lockValueThread;
+  Freezer* freezer;
+  ChangeProfiler* changeProfiler;
+  bool skipVolatile;
   bool canResumeProcess;
   bool isProcessPaused;
+  std::thread* scanThread;
+  ScanProgressPtr scanProgress;
+  std::atomic<bool> scanning;
 
   string notes;
 };
@@ -1,25 +1,98 @@
 #ifndef MEM_IO_H
 #define MEM_IO_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
+#include <sys/types.h>
 #include "med/MedTypes.hpp"
 #include "mem/Mem.hpp"
 
+/**
+ * Range of the process memory to be read into the buffer.
+ */
+struct MemRange {
+  Address address;
+  size_t size;
+  Byte* buffer;
+  bool valid;
+};
+
+struct MemIOStats {
+  size_t bytesNeeded;
+  size_t bytesRead;
+  size_t syscalls;
+};
+
 class MemIO {
 public:
   MemIO();
+  ~MemIO();
   void setPid(pid_t pid);
   pid_t getPid();
   MemPtr read(Address addr, size_t size);
+
+  /**
+   * Read into the buffer without ptrace attach, using the shared /proc/pid/mem.
+   * Thread safe. Return number of bytes read, or -1 if failed.
+   */
+  ssize_t read(Address addr, Byte* buffer, size_t size);
+
+  /**
+   * Read the ranges, small ranges are batched by process_vm_readv, large ranges by pread.
+   * Each range is marked valid if it is fully read.
+   * @param bytesNeeded bytes that the caller actually uses, for the stats. 0 means all.
+   * @return number of valid ranges
+   */
+  size_t read(std::vector<MemRange>& ranges, size_t bytesNeeded = 0);
+
+  MemIOStats getStats();
+  void resetStats();
+
+  /**
+   * Reads by the calling thread, of all the MemIO, never reset.
+   * Take the difference before and after the reads, so that other threads are not counted.
+   */
+  static MemIOStats getThreadStats();
   void write(Address addr, MemPtr mem, size_t size = 0);
 
+  /**
+   * Write the buffers of the ranges in batch by process_vm_writev, without ptrace attach.
+   * Range that cannot be written this way (e.g. read-only page) is written by pwrite.
+   * Each range is marked valid if it is fully written.
+   * @return number of written ranges
+   */
+  size_t write(std::vector<MemRange>& ranges);
+
 private:
   MemPtr readProcess(Address addr, size_t size);
   MemPtr readDirect(Address addr, size_t size);
   void writeProcess(Address addr, MemPtr mem, size_t size);
   void writeDirect(Address addr, MemPtr mem, size_t size);
-  pid_t pid;
+  typedef std::shared_ptr<int> MemFdPtr; // Closed when the last holder releases it
+
+  /**
+   * Hold the returned fd during the syscall, so that setPid() does not close it in use.
+   * @return NULL if failed
+   */
+  MemFdPtr getMemFd();
+  void countRead(size_t needed, size_t read, size_t calls);
+  size_t readByPread(MemRange& range);
+  size_t readByVector(std::vector<MemRange>& ranges, size_t start, size_t end);
+  size_t writeByPwrite(MemRange& range);
+  size_t writeByVector(std::vector<MemRange>& ranges, size_t start, size_t end);
+  std::atomic<pid_t> pid; // Changed with the memFd under the memFdMutex
   std::mutex mutex;
+
+  MemFdPtr memFd;
+  std::mutex memFdMutex;
+  std::atomic<bool> canReadVector;
+  std::atomic<bool> canWriteVector;
+
+  std::atomic<size_t> bytesNeeded;
+  std::atomic<size_t> bytesRead;
+  std::atomic<size_t> syscalls;
 };
 
 #endif
@@ -18,6 +18,12 @@ public:
   Address getAddress(int index);
   string getValue(int index, const string& scanType);
   string getValue(int index);
+
+  /**
+   * Values of the first "count" items, read in batch per process. Empty string if not readable.
+   */
+  vector<string> getValues(size_t count);
+  vector<string> getValues();
   string getScanType(int index);
   void dump(int index, bool newline = true);
 
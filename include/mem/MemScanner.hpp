@@ -11,9 +11,13 @@
 #include "med/Operands.hpp"
 #include "med/MedCommon.hpp"
 #include "med/ScanCommand.hpp"
+#include "med/DeltaMatcher.hpp"
+#include "med/RecordMatcher.hpp"
 #include "mem/Mem.hpp"
 #include "mem/MemIO.hpp"
 #include "mem/ScanParams.hpp"
+#include "mem/ScanProgress.hpp"
+#include "mem/ScanStats.hpp"
 
 using namespace std;
 
@@ -45,8 +49,19 @@ public:
   vector<MemPtr> filterUnknownWithList(const vector<MemPtr>& list,
                                        const string& scanType,
                                        const ScanParser::OpType& op);
+  vector<MemPtr> filterDelta(const vector<MemPtr>& list,
+                             DeltaMatcher& matcher,
+                             bool fastScan = false);
+  vector<MemPtr> filterDeltaWithList(const vector<MemPtr>& list, DeltaMatcher& matcher);
   vector<MemPtr>& saveSnapshot(const vector<MemPtr>& baseList);
   vector<MemPtr> filterSnapshot(const string& scanType, const ScanParser::OpType& op, bool fastScan = false);
+  vector<MemPtr> filterSnapshot(DeltaMatcher& matcher, bool fastScan = false);
+
+  /**
+   * Find the arrays of at least "min records" consecutive records matching the predicates,
+   * in one pass of each region. The results are the starts of all the matched records of the arrays.
+   */
+  vector<MemPtr> scanRecords(RecordMatcher& matcher);
 
   vector<MemPtr> scanInner(Operands& operands,
                            int size,
@@ -65,6 +80,7 @@ public:
   vector<MemPtr> filterUnknownInner(const vector<MemPtr>& list,
                                     const string& scanType,
                                     const ScanParser::OpType& op);
+  vector<MemPtr> filterDeltaInner(const vector<MemPtr>& list, DeltaMatcher& matcher);
 
   AddressPair* getScope();
   void setScopeStart(Address addr);
@@ -72,15 +88,46 @@ public:
 
   std::mutex& getListMutex();
 
+  /**
+   * Ranges skipped by the scan, such as the volatile ranges found by ChangeProfiler.
+   * Filter is not affected.
+   */
+  void setExcludedRanges(const AddressPairs& ranges);
+
+  /**
+   * Cost of the last scan or filter
+   */
+  ScanStats getStats();
+
+  /**
+   * Progress of the following scans and filters, such as a new handle for each async scan
+   */
+  void setProgress(ScanProgressPtr progress);
+  ScanProgressPtr getProgress();
+
+  /**
+   * Threads of each scan or filter, such as the share of a process in a multi-process session
+   */
+  void setMaxThreads(int num);
+  int getMaxThreads();
+
+  static const int DEFAULT_MAX_THREADS = 8;
+
 private:
   void initialize();
   Maps getInterestedMaps(Maps& maps, const vector<MemPtr>& list);
+  bool readSnapshotBlock(MemPtr& oldBlock, MemPtr& newBlock);
   void compareBlocks(vector<MemPtr>& list,
                      MemPtr& oldBlock,
                      MemPtr& newBlock,
                      const string& scanType,
                      const ScanParser::OpType& op,
                      bool fastScan = false);
+  void compareBlocks(vector<MemPtr>& list,
+                     MemPtr& oldBlock,
+                     MemPtr& newBlock,
+                     DeltaMatcher& matcher,
+                     bool fastScan = false);
 
   vector<MemPtr> scanByMaps(Operands& operands,
                             int size,
@@ -99,16 +146,28 @@ private:
                       int fd,
                       std::mutex& fdMutex,
                       ScanCommand &scanCommand,
+                      ScanStatsRecorder& stats,
+                      ScanProgress* progress,
                       Integers lastDigits = Integers(),
                       bool fastScan = false);
 
+  static void scanRecordMap(MemIO* memio,
+                            std::mutex& mutex,
+                            vector<MemPtr>& list,
+                            Maps& maps,
+                            int mapIndex,
+                            RecordMatcher& matcher,
+                            ScanStatsRecorder& stats,
+                            ScanProgress* progress);
+
   vector<MemPtr>& saveSnapshotByScope();
   vector<MemPtr>& saveSnapshotByList(const vector<MemPtr>& baseList);
 
   static void saveSnapshotMap(MemIO* memio,
                               vector<MemPtr>& snapshot,
                               Maps& maps,
-                              int mapIndex);
+                              int mapIndex,
+                              ScanStatsRecorder& stats);
   static void scanPage(MemIO* memio,
                        std::mutex& mutex,
                        vector<MemPtr>& list,
@@ -118,6 +177,8 @@ private:
                        int size,
                        const string& scanType,
                        const ScanParser::OpType& op,
+                       ScanStatsRecorder& stats,
+                       ScanProgress* progress,
                        bool fastScan = false,
                        Integers lastDigits = Integers());
   static void scanPage(MemIO* memio,
@@ -126,29 +187,12 @@ private:
                        Byte* page,
                        Address start,
                        ScanCommand &scanCommand,
+                       ScanStatsRecorder& stats,
+                       ScanProgress* progress,
                        Integers lastDigits = Integers(),
                        bool fastScan = false);
 
-  static void filterByChunk(std::mutex& mutex,
-                            const vector<MemPtr>& list,
-                            vector<MemPtr>& newList,
-                            int listIndex,
-                            Operands& operands,
-                            int size,
-                            const string& scanType,
-                            const ScanParser::OpType& op);
-  static void filterByChunk(std::mutex& mutex,
-                            const vector<MemPtr>& list,
-                            vector<MemPtr>& newList,
-                            int listIndex,
-                            ScanCommand &scanCommand);
-  static void filterUnknownByChunk(std::mutex& mutex,
-                                   const vector<MemPtr>& list,
-                                   vector<MemPtr>& newList,
-                                   int listIndex,
-                                   const string& scanType,
-                                   const ScanParser::OpType& op);
-
+  size_t excludeRanges(Maps& maps);
   bool hasScope();
 
   pid_t pid;
@@ -156,6 +200,9 @@ private:
   MemIO* memio;
   vector<MemPtr> snapshot;
   AddressPair* scope;
+  AddressPairs excludedRanges;
+  ScanStatsRecorder stats;
+  ScanProgressPtr progress;
   std::mutex listMutex;
 };
 
@@ -0,0 +1,83 @@
+#ifndef MEM_WINDOW_HPP
+#define MEM_WINDOW_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+/**
+ * Paged cache of the memory around the view, such as the memory editor.
+ * On each update, the pages of the view are read again in batch, and the bytes that differ
+ * are marked with the update number. The pages before and after the view are prefetched
+ * when not cached, so that scrolling shows the cached bytes without waiting for the read.
+ */
+class MemWindow {
+public:
+  explicit MemWindow(MemIO* memio, size_t pageSize = DEFAULT_PAGE_SIZE);
+
+  void setView(Address start, size_t size);
+  Address getViewStart();
+  size_t getViewSize();
+
+  /**
+   * Number of pages to prefetch on each side of the view
+   */
+  void setPrefetch(size_t pages);
+  void setMaxPages(size_t pages);
+
+  /**
+   * Read the pages of the view, and the missing prefetch pages.
+   * @return number of readable pages read
+   */
+  size_t update();
+
+  /**
+   * Copy the cached bytes.
+   * @return false if any of the bytes is not cached or not readable
+   */
+  bool get(Address address, Byte* buffer, size_t size);
+  bool isReadable(Address address);
+
+  /**
+   * Number of updates since the byte was changed, NEVER_CHANGED if not changed since cached
+   */
+  uint32_t getAge(Address address);
+  uint32_t getGeneration();
+
+  size_t getPageSize();
+  size_t getNumOfPages();
+  void clear();
+
+  static const size_t DEFAULT_PAGE_SIZE = 4096;
+  static const size_t DEFAULT_PREFETCH = 4;
+  static const size_t DEFAULT_MAX_PAGES = 1024; // 4MB
+  static const uint32_t NEVER_CHANGED = UINT32_MAX;
+
+private:
+  struct Page {
+    vector<Byte> data;
+    vector<uint32_t> changedAt; // Update number, 0 if never changed
+    bool valid;
+    uint32_t usedAt;
+  };
+
+  Page* findPage(Address address);
+  Address pageOf(Address address);
+  void evict(Address first, Address last);
+
+  MemIO* memio;
+  size_t pageSize;
+  size_t prefetch;
+  size_t maxPages;
+  Address viewStart;
+  size_t viewSize;
+  uint32_t generation;
+  map<Address, Page> pages;
+};
+
+#endif
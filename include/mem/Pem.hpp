@@ -1,3 +1,6 @@
+#ifndef PEM_HPP
+#define PEM_HPP
+
 #include "mem/Mem.hpp"
 #include "mem/MemIO.hpp"
 #include "med/SizedBytes.hpp"
@@ -26,6 +29,11 @@ public:
 
   MemIO* getMemIO();
   static string bytesToString(Byte* value, const string& scanType);
+
+  /**
+   * String is terminated by the size, because the bytes are not terminated
+   */
+  static string bytesToString(Byte* value, size_t size, const string& scanType);
   static SizedBytes stringToBytes(const string& value, const string& scanType);
 
   static std::shared_ptr<Pem> convertToPemPtr(MemPtr mem, MemIO* memio);
@@ -37,3 +45,5 @@ private:
 };
 
 typedef std::shared_ptr<Pem> PemPtr;
+
+#endif
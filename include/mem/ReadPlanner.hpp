@@ -0,0 +1,61 @@
+#ifndef READ_PLANNER_HPP
+#define READ_PLANNER_HPP
+
+#include <vector>
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+/**
+ * Plan the reads of many small values, such as filter candidates and the store.
+ * Addresses are merged into one range when the gap between them is below the threshold,
+ * then all the ranges are read by MemIO in batch.
+ */
+class ReadPlanner {
+public:
+  explicit ReadPlanner(size_t maxGap = DEFAULT_MAX_GAP);
+
+  void add(Address address, size_t size);
+  void clear();
+  size_t size();
+
+  void setMaxGap(size_t maxGap);
+  size_t getMaxGap();
+
+  /**
+   * Read all the values. If a merged range is not readable, its values are read one by one.
+   * @return number of readable values
+   */
+  size_t read(MemIO* memio);
+
+  /**
+   * Value by the order of add(). NULL if not readable.
+   */
+  Byte* getData(size_t index);
+
+  vector<MemRange>& getRanges();
+  size_t getBytesNeeded();
+  size_t getBytesPlanned();
+
+  static const size_t DEFAULT_MAX_GAP = 512;
+  static const size_t MAX_RANGE_SIZE = 256 * 1024;
+
+private:
+  struct Request {
+    Address address;
+    size_t size;
+    size_t range;
+    size_t offset; // In the range
+    bool valid;
+  };
+
+  void plan();
+
+  size_t maxGap;
+  vector<Request> requests;
+  vector<MemRange> ranges;
+  vector<Byte> buffer;
+};
+
+#endif
@@ -8,6 +8,8 @@
 #include "med/Operands.hpp"
 #include "mem/MemIO.hpp"
 #include "mem/Maps.hpp"
+#include "mem/ScanProgress.hpp"
+#include "mem/ScanStats.hpp"
 
 using namespace std;
 
@@ -23,8 +25,10 @@ struct ScanParams {
   int size;
   const string& scanType;
   const ScanParser::OpType& op;
+  ScanStatsRecorder& stats;
   bool fastScan = false;
   Integers lastDigits = Integers();
+  ScanProgress* progress = NULL;
 };
 
 #endif
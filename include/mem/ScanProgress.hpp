@@ -0,0 +1,78 @@
+#ifndef SCAN_PROGRESS_HPP
+#define SCAN_PROGRESS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mem/Mem.hpp"
+
+using namespace std;
+
+const size_t MAX_PARTIAL_RESULTS = 10000; // Partial results kept for display, the rest are only counted
+
+/**
+ * Handle of a running scan or filter. Thread safe.
+ * The scan tasks report the bytes and regions done, and the matches of each page as partial results.
+ * Cancel stops the tasks at the next page (or chunk of a filter), the results found so far are kept.
+ */
+class ScanProgress {
+public:
+  ScanProgress();
+
+  void begin(size_t bytes, size_t regions);
+
+  /**
+   * Scans of several processes report to the same progress, so each begin() adds to the totals
+   */
+  void setShared(bool shared);
+  void addBytes(size_t bytes);
+  void addRegion();
+
+  size_t getBytesDone();
+  size_t getBytesTotal();
+  size_t getRegionsDone();
+  size_t getRegionsTotal();
+  double getFraction();
+
+  void cancel();
+  bool isCancelled();
+
+  void addPartial(const vector<MemPtr>& found);
+
+  /**
+   * Partial results since the last call
+   */
+  vector<MemPtr> takePartial();
+  size_t getMatches();
+
+  void finish(const vector<MemPtr>& results, const string& error = "");
+  bool isFinished();
+  void wait();
+  vector<MemPtr> getResults();
+  string getError();
+
+private:
+  std::atomic<size_t> bytesDone;
+  std::atomic<size_t> bytesTotal;
+  std::atomic<size_t> regionsDone;
+  std::atomic<size_t> regionsTotal;
+  std::atomic<size_t> matches;
+  std::atomic<bool> cancelled;
+  std::atomic<bool> shared;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  vector<MemPtr> partial;
+  size_t partialKept;
+  bool finished;
+  vector<MemPtr> results;
+  string error;
+};
+
+typedef std::shared_ptr<ScanProgress> ScanProgressPtr;
+
+#endif
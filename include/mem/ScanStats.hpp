@@ -0,0 +1,76 @@
+#ifndef SCAN_STATS_HPP
+#define SCAN_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/**
+ * Cost of the last scan or filter.
+ * Wall time is of the whole operation, other times are summed over all the tasks, in ms.
+ */
+struct ScanStats {
+  string operation;
+  size_t bytesRead;
+  size_t syscalls;
+  size_t pagesRead;
+  size_t pagesSkipped; // Not readable, or excluded from the scan
+  size_t results;
+  size_t tasks;
+  int threads;
+  double wallTime;
+  double readTime;
+  double compareTime;
+  double materializeTime;
+  double lockWaitTime;
+  double threadUtilization; // Busy time of the tasks over the time of all the threads, 0 to 1
+
+  string toString() const;
+  string toSummary() const;
+};
+
+/**
+ * Collect the costs from the scan tasks. Thread safe.
+ */
+class ScanStatsRecorder {
+public:
+  ScanStatsRecorder();
+
+  void begin(const string& operation, int threads);
+  void end(size_t results);
+  ScanStats getStats();
+
+  void addRead(size_t bytes, size_t syscalls, int64_t ns);
+  void addPages(size_t read, size_t skipped);
+  void addCompare(int64_t ns);
+  void addMaterialize(int64_t ns);
+  void addLockWait(int64_t ns);
+  void addTask(int64_t ns);
+
+  /**
+   * Monotonic time in ns
+   */
+  static int64_t now();
+
+private:
+  string operation;
+  int threads;
+  int64_t beginTime;
+  ScanStats stats;
+
+  std::atomic<size_t> bytesRead;
+  std::atomic<size_t> syscalls;
+  std::atomic<size_t> pagesRead;
+  std::atomic<size_t> pagesSkipped;
+  std::atomic<size_t> tasks;
+  std::atomic<int64_t> readTime;
+  std::atomic<int64_t> compareTime;
+  std::atomic<int64_t> materializeTime;
+  std::atomic<int64_t> lockWaitTime;
+  std::atomic<int64_t> taskTime;
+};
+
+#endif
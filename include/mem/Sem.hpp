@@ -1,6 +1,14 @@
+#ifndef SEM_HPP
+#define SEM_HPP
+
+#include <atomic>
+#include <mutex>
 #include "mem/Pem.hpp"
 #include "mem/MemIO.hpp"
 
+// Default interval of writing the locked value, in millisecond
+const int LOCK_REFRESH_RATE = 800;
+
 // This is Sem (Saved/stored process mEMory). Derived from Pem
 class Sem : public Pem {
 public:
@@ -15,15 +23,43 @@ public:
 
   void setLockedValue(string s);
   string& getLockedValue();
+
+  /**
+   * Locked value encoded by the scan type. It is encoded when the value is locked or edited,
+   * and again only if the scan type is changed. Empty if the value cannot be encoded.
+   */
+  SizedBytes getLockedBytes();
   void lockValue();
 
+  /**
+   * Interval of writing the locked value, in millisecond. Minimum is 1.
+   */
+  int getLockInterval();
+  void setLockInterval(int ms);
+
+  /**
+   * Number of times the locked value is written back because it was changed.
+   * Only counted when the freezer writes only if changed.
+   */
+  size_t getCorrections();
+  void addCorrection();
+
   static std::shared_ptr<Sem> clone(shared_ptr<Sem> semPtr);
   static std::shared_ptr<Sem> convertToSemPtr(PemPtr);
 
 private:
-  bool locked;
+  std::atomic<bool> locked; // Read by the freezer thread
   string description;
   string lockedValue;
+  SizedBytes lockedBytes;
+  string lockedScanType;
+  std::atomic<int> lockInterval;
+  std::atomic<size_t> corrections;
+  std::mutex lockMutex; // Locked value is read by the freezer thread
+
+  void encodeLockedValue();
 };
 
 typedef std::shared_ptr<Sem> SemPtr;
+
+#endif
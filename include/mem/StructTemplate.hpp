@@ -0,0 +1,75 @@
+#ifndef STRUCT_TEMPLATE_HPP
+#define STRUCT_TEMPLATE_HPP
+
+#include <string>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+/**
+ * Field of the compiled template. The nested fields are relative to the value of their pointer field.
+ */
+struct StructField {
+  string name; // Such as "pos[1]" and "owner.level"
+  int base; // Index of the pointer field, -1 if relative to the instance
+  size_t offset;
+  size_t size;
+  string scanType;
+};
+
+/**
+ * Layout of a struct, to decode the fields of many instances. The definition has one field per line,
+ *
+ *   hp      0x10 int32
+ *   pos     0x14 float32[3]
+ *   name    0x20 string[16]
+ *   owner   0x40 ptr64 {
+ *     level 0x8  int32
+ *   }
+ *
+ * "#" starts a comment. The fields are compiled into a flat list, and the fields with the same base
+ * into one block, so each instance, and each pointer followed, costs one read.
+ */
+class StructTemplate {
+public:
+  StructTemplate();
+  explicit StructTemplate(const string& definition);
+
+  /**
+   * Parse and compile the definition, replacing the current fields.
+   * Throws MedException with the line number if it is invalid.
+   */
+  void compile(const string& definition);
+
+  const vector<StructField>& getFields();
+  vector<string> getFieldNames();
+  size_t getNumOfFields();
+
+  /**
+   * Decode all the fields of the instances, by the order of getFields().
+   * The blocks of the same depth are read in one batch. A field is empty if it is not readable,
+   * or if its pointer is null.
+   */
+  vector<vector<string>> read(MemIO* memio, const vector<Address>& addresses);
+
+  static const size_t MAX_ARRAY_SIZE = 4096;
+
+private:
+  struct Block {
+    int base;
+    size_t offset;
+    size_t size;
+    vector<size_t> fields;
+  };
+
+  void addField(const string& line, int lineNumber, vector<int>& parents);
+  void plan();
+
+  vector<StructField> fields;
+  vector<vector<Block>> stages; // Blocks by the depth of the pointers
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef TYPE_ANALYZER_HPP
+#define TYPE_ANALYZER_HPP
+
+#include <string>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/Maps.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+struct TypeGuess {
+  string kind; // "int", "float", "double", "pointer", "string", "bool", or "unknown"
+  string scanType;
+  double confidence; // 0 to 1
+};
+
+/**
+ * Guess the types of the values, by sampling them over time.
+ * Each sample reads 8 bytes of all the addresses in batch. A value is judged by
+ * the pointers into the readable maps, the sane exponents of floats and doubles,
+ * the printable bytes of strings, and how the value changes between the samples.
+ */
+class TypeAnalyzer {
+public:
+  explicit TypeAnalyzer(MemIO* memio);
+
+  /**
+   * Maps that the pointers point into, such as all the readable maps
+   */
+  void setMaps(const Maps& maps);
+
+  /**
+   * Replace the addresses, the samples are cleared
+   */
+  void setAddresses(const vector<Address>& addresses);
+  const vector<Address>& getAddresses();
+
+  /**
+   * Read all the addresses once, an unreadable address has no sample this time
+   */
+  void sample();
+  size_t getNumOfSamples();
+
+  /**
+   * Guesses by the order of the addresses
+   */
+  vector<TypeGuess> classify();
+
+  static TypeGuess classify(const vector<uint64_t>& samples, Maps& maps);
+
+  static const size_t SAMPLE_SIZE = 8;
+
+private:
+  MemIO* memio;
+  Maps maps;
+  vector<Address> addresses;
+  vector<vector<uint64_t>> samples; // By address
+  size_t numOfSamples;
+};
+
+#endif
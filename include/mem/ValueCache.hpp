@@ -0,0 +1,81 @@
+#ifndef VALUE_CACHE_HPP
+#define VALUE_CACHE_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+struct ValueRequest {
+  size_t row;
+  Address address;
+  size_t size;
+  string scanType;
+  MemIO* memio; // Process of the value, or NULL for the MemIO of the cache
+};
+
+struct CachedValue {
+  size_t row;
+  Address address;
+  string value; // Empty if not readable
+};
+
+/**
+ * Read the values of the visible rows in the background, so that the UI never reads the memory.
+ * The requests are grouped by name, such as "scan" and "store". The worker reads each group in batch
+ * into the back buffer, then swaps it with the front buffer, and calls the callback.
+ * The values are copied out of the front buffer, so a reader never waits for the reads.
+ */
+class ValueCache {
+public:
+  explicit ValueCache(MemIO* memio);
+  ~ValueCache();
+
+  void setRequests(const string& name, const vector<ValueRequest>& requests);
+  vector<CachedValue> getValues(const string& name);
+
+  /**
+   * Called by the worker thread after each update
+   */
+  void setCallback(std::function<void()> callback);
+  void setInterval(int ms);
+
+  void start();
+  void stop();
+
+  /**
+   * Wake up the worker to update now
+   */
+  void refresh();
+
+  /**
+   * Read all the requests once, called by the worker on each interval
+   */
+  void update();
+
+private:
+  void run();
+
+  MemIO* memio;
+  map<string, vector<ValueRequest>> requests;
+  map<string, vector<CachedValue>> front;
+  std::function<void()> callback;
+  int interval;
+
+  std::mutex mutex; // Guards the requests, the front buffer and the settings
+  std::mutex updateMutex;
+  std::condition_variable cv;
+  std::thread* thread;
+  bool running;
+  bool pending;
+};
+
+#endif
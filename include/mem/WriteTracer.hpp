@@ -0,0 +1,85 @@
+#ifndef WRITE_TRACER_HPP
+#define WRITE_TRACER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+
+#include "med/MedTypes.hpp"
+
+using namespace std;
+
+struct WriteHit {
+  Address ip;
+  size_t count;
+  string location; // module+offset
+};
+
+/**
+ * Find what writes to the address, by the x86 debug registers (DR0 and DR7) of all the threads.
+ * All the ptrace calls are done by the event loop thread, which attaches once, arms the threads
+ * (including the threads created later) and counts the instruction pointer of each write.
+ * The write trap is reported after the instruction, so the instruction pointer is the next instruction.
+ * SIGUSR2 is used to wake up the event loop thread when stopping, its previous handler is restored by stop().
+ *
+ * Only supported on x86_64, otherwise start() throws MedException.
+ */
+class WriteTracer {
+public:
+  explicit WriteTracer(pid_t pid);
+  ~WriteTracer();
+
+  /**
+   * @param size 1, 2, 4 or 8, the address must be aligned to the size.
+   */
+  void start(Address address, size_t size);
+  void stop();
+  bool isRunning();
+
+  /**
+   * Hits sorted by count, the most frequent first.
+   */
+  vector<WriteHit> getHits();
+  void clearHits();
+
+  static bool isSupported();
+
+private:
+  void run(Address address, size_t size);
+  void attachAll(Address address, size_t size);
+  void attachThread(pid_t tid, Address address, size_t size);
+  void loop(Address address, size_t size);
+  void detachAll();
+  pid_t waitTracee(int& status, bool block);
+  bool isTracee(pid_t tid);
+  void addClone(pid_t tid);
+  void notifyReady(const string& error);
+
+  pid_t pid;
+  std::thread* thread;
+  std::atomic<bool> running;
+  std::atomic<bool> stopping; // stop() signals the event loop thread, so that waitpid() is interrupted
+  struct sigaction previousWakeAction;
+
+  // Only used by the event loop thread
+  set<pid_t> threads;
+  set<pid_t> clones; // Reported by PTRACE_EVENT_CLONE, but not yet stopped
+
+  std::mutex readyMutex;
+  std::condition_variable readyCv;
+  bool ready;
+  string error;
+
+  std::mutex hitsMutex;
+  unordered_map<Address, size_t> hits;
+};
+
+#endif
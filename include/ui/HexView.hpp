@@ -0,0 +1,78 @@
+#ifndef HEX_VIEW_HPP
+#define HEX_VIEW_HPP
+
+#include <vector>
+#include <QAbstractScrollArea>
+
+#include "med/MedTypes.hpp"
+#include "mem/MemWindow.hpp"
+
+const int HEX_VIEW_BYTES_PER_LINE = 16;
+const Address HEX_VIEW_BROWSE_SIZE = 4 * 1024 * 1024; // Scrollable on each side of the base address
+const uint32_t HEX_VIEW_HIGHLIGHT_UPDATES = 60; // 2 seconds at 30 fps
+
+/**
+ * Hex view painting only the visible lines from the memory window.
+ * On refresh, only the lines whose bytes or highlight are changed are repainted.
+ */
+class HexView : public QAbstractScrollArea {
+  Q_OBJECT
+
+public:
+  explicit HexView(MemWindow* memWindow, QWidget* parent = 0);
+
+  /**
+   * Scroll to the address, and center the scrollable range around it
+   */
+  void setBaseAddress(Address address);
+  Address getBaseAddress();
+
+  void setCursorAddress(Address address);
+  Address getCursorAddress();
+
+  /**
+   * Read the visible memory, and repaint the changed lines
+   */
+  void refresh();
+
+signals:
+  void cursorAddressChanged(Address address);
+  void byteEdited(Address address, Byte value);
+
+protected:
+  void paintEvent(QPaintEvent* event) override;
+  void keyPressEvent(QKeyEvent* event) override;
+  void mousePressEvent(QMouseEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+  void scrollContentsBy(int dx, int dy) override;
+
+private:
+  struct Line {
+    vector<Byte> bytes;
+    vector<bool> readable;
+    vector<bool> highlighted;
+  };
+
+  Address getTopAddress();
+  int getVisibleLines();
+  void updateScrollBar();
+  void updateView();
+  Line readLine(Address address);
+  QRect getLineRect(int line);
+  void ensureCursorVisible();
+  void moveCursor(long offset);
+
+  MemWindow* memWindow;
+  Address rangeStart;
+  Address baseAddress;
+  Address cursorAddress;
+  bool isLowNibble;
+  vector<Line> shownLines; // Lines painted, by the line from the top
+
+  int charWidth;
+  int lineHeight;
+  int hexX;
+  int textX;
+};
+
+#endif
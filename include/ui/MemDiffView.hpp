@@ -0,0 +1,55 @@
+#ifndef MEM_DIFF_VIEW_HPP
+#define MEM_DIFF_VIEW_HPP
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QLabel>
+#include <QTreeWidget>
+
+#include "ui/Ui.hpp"
+#include "mem/MemDiff.hpp"
+
+const int MEM_DIFF_MAX_RANGES = 10000; // Shown in the tree
+
+/**
+ * Compare the snapshots of a region, or a snapshot with the live memory.
+ * The changed ranges are listed with the values before and after by the selected type,
+ * and the offsets from the region start, such as the fields of a struct.
+ */
+class MemDiffView : public QWidget {
+  Q_OBJECT
+
+public:
+  explicit MemDiffView(MedUi* mainUi);
+  virtual ~MemDiffView();
+
+private slots:
+  void onSnapshotAClicked();
+  void onSnapshotBClicked();
+  void onDiffClicked();
+  void onDiffLiveClicked();
+  void onScanTypeComboChanged(int index);
+
+private:
+  bool readRegion(Address& address, size_t& size);
+  void showRanges();
+
+  MedUi* mainUi;
+  MemDiff* memDiff;
+
+  QLineEdit* addressLine;
+  QLineEdit* sizeLine;
+  QLineEdit* gapLine;
+  QComboBox* scanTypeCombo;
+  QLabel* statusLabel;
+  QTreeWidget* resultTree;
+
+  MemSnapshot snapshotA;
+  MemSnapshot snapshotB;
+  bool hasSnapshotA;
+  bool hasSnapshotB;
+  vector<DiffRange> ranges;
+};
+
+#endif
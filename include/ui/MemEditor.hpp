@@ -4,15 +4,15 @@
 #include <string>
 #include <QWidget>
 #include <QLineEdit>
-#include <QPlainTextEdit>
 #include <QPushButton>
 
 #include "ui/Ui.hpp"
+#include "ui/HexView.hpp"
 #include "med/MedTypes.hpp"
 #include "mem/MemEd.hpp"
+#include "mem/MemWindow.hpp"
 
-const int MEMORY_SIZE = 384; // 12 lines
-const int ADDRESS_LINE = 24;
+const int MEM_EDITOR_REFRESH_RATE = 33; // ms, 30 fps
 
 class MemEditor : public QWidget {
   Q_OBJECT
@@ -21,22 +21,21 @@ public:
   explicit MemEditor(MedUi* mainUi);
   virtual ~MemEditor();
 
-  QPlainTextEdit* memArea;
-  std::string memHex;
-
-  void writeToProcessMemory(int position, char ch);
   void refresh();
-  void updateAddresses();
 
   void setBaseAddress(Address addr);
   Address getBaseAddress();
 
-  void boldText();
+protected:
+  void showEvent(QShowEvent* event) override;
+  void hideEvent(QHideEvent* event) override;
 
 private slots:
   void onCurrAddressEdited();
-  void onMemAreaCursorPositionChanged();
+  void onCursorAddressChanged(Address address);
+  void onByteEdited(Address address, Byte value);
   void onRefreshButtonClicked();
+  void onRefreshTimeout();
   void onScanTypeComboChanged(int index);
   void onEnterClicked();
 
@@ -45,39 +44,25 @@ private:
   MedUi* mainUi;
   QWidget* parent;
   QWidget* mainChild;
-  Address baseAddress;
 
   QLineEdit* currAddress;
   QLineEdit* valueLine;
-  QPlainTextEdit* addrArea;
-  QPlainTextEdit* textArea;
   QPushButton* refreshButton;
   QComboBox *scanTypeCombo;
   QLineEdit *viewInt32;
   QLineEdit *viewFloat32;
   QLineEdit *viewFloat64;
   QPushButton *enterButton;
+  QTimer* refreshTimer;
 
-  Byte* rawMemory; // For re-use without keep read from PID
+  MemWindow* memWindow; // Cached memory around the view, read on each refresh
+  HexView* hexView;
 
   void setupSignals();
 
-  void loadMemory(Address address, size_t size = MEMORY_SIZE); // 12 lines
-  void loadAddresses(Address address, size_t size = ADDRESS_LINE);
-
-  void updateCurrAddress();
   void updateValueLine();
   void updateValueViews();
-  void storeRawMemory(Byte* memory, size_t size);
-
-  string getHexString(int position);
-  Address getAddressByCursorPosition(int position);
-  void setCursorPositionByAddress();
-
-  static std::string memoryToHex(Byte* memory, size_t size);
-  static std::string memoryToString(Byte* memory, size_t size, EncodingManager* encodingManager);
-
-  void clearFormat();
+  string getValue(Address address, const string& scanType);
 };
 
 #endif
@@ -0,0 +1,72 @@
+#ifndef SCAN_TABLE_MODEL_HPP
+#define SCAN_TABLE_MODEL_HPP
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QModelIndex>
+#include <QVariant>
+
+#include "mem/MemEd.hpp"
+#include "mem/ValueCache.hpp"
+#include "mem/TypeAnalyzer.hpp"
+
+class MedUi;
+
+/**
+ * Lazy model over the scan list. No item is created for the rows, the cells are made from the list
+ * when the view asks for them. The values of the visible rows are read by the value cache, and
+ * a row without the read value shows the value remembered by the scan, so data() never reads the memory.
+ */
+class ScanTableModel : public QAbstractTableModel {
+  Q_OBJECT
+public:
+  ScanTableModel(MedUi* mainUi, QObject* parent = 0);
+
+  QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+  bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) Q_DECL_OVERRIDE;
+  Qt::ItemFlags flags(const QModelIndex &index) const Q_DECL_OVERRIDE;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+  int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+  /**
+   * Show the scan list, called whenever the list is replaced
+   */
+  void refresh();
+  void clearAll();
+
+  /**
+   * Append the partial results of a running scan, up to "limit" rows.
+   * The values are the remembered values, so no memory is read.
+   */
+  void addPartial(const vector<MemPtr>& mems, const string& scanType, int limit);
+
+  /**
+   * Apply the values read by the value cache, only the changed rows are updated.
+   * A value is skipped if its row no longer has the requested address.
+   */
+  void applyValues(const vector<CachedValue>& values);
+  void empty(); //including the med data
+
+  /**
+   * Suggested types by the order of the addresses, which are the first rows of the scan list.
+   * They are kept until the list is replaced.
+   */
+  void setSuggestions(const vector<Address>& addresses, const vector<TypeGuess>& guesses);
+
+private:
+  PemPtr getPem(int row) const;
+  string convertToUtf8(const string& str, const string& scanType) const;
+
+  MedUi* mainUi;
+  MemEd* med;
+  size_t count; // Rows of the scan list, fixed until refresh()
+  vector<MemPtr> partial;
+  string partialScanType;
+  bool isPartial;
+  QHash<int, QString> values; // Values of the visible rows, by the value cache
+  QHash<int, QString> suggestions;
+};
+
+#endif
@@ -20,7 +20,7 @@ public:
   bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) Q_DECL_OVERRIDE;
   Qt::ItemFlags flags(const QModelIndex &index) const Q_DECL_OVERRIDE;
   void refresh();
-  void refreshValues(); //Refresh values only
+  void applyValues(const vector<CachedValue>& values);
   void addRow();
 
   void sortByDescription();
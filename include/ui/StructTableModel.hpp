@@ -0,0 +1,45 @@
+#ifndef STRUCT_TABLE_MODEL_HPP
+#define STRUCT_TABLE_MODEL_HPP
+
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QVariant>
+
+#include "med/MedTypes.hpp"
+
+/**
+ * Decoded fields of the struct instances, one row per instance and one column per field.
+ * The values are set in batch after each read, so data() never reads the memory.
+ */
+class StructTableModel : public QAbstractTableModel {
+  Q_OBJECT
+public:
+  explicit StructTableModel(QObject* parent = 0);
+
+  QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+  int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+  /**
+   * Replace the instances and the fields, the values are cleared
+   */
+  void reset(const vector<Address>& addresses, const vector<string>& fieldNames);
+
+  /**
+   * Values by instance then by field, only the changed rows are updated
+   */
+  void setValues(const vector<vector<string>>& values);
+
+  const vector<Address>& getAddresses();
+
+private:
+  void emitRowsChanged(int first, int last);
+
+  vector<Address> addresses;
+  vector<string> fieldNames;
+  vector<vector<string>> values;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef STRUCT_VIEW_HPP
+#define STRUCT_VIEW_HPP
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QTableView>
+
+#include "ui/Ui.hpp"
+#include "ui/StructTableModel.hpp"
+#include "mem/StructTemplate.hpp"
+
+const int STRUCT_VIEW_MAX_INSTANCES = 10000; // From the scan list
+const int STRUCT_VIEW_REFRESH_RATE = 800; // ms
+
+/**
+ * Decode a struct template over an address, or over every address of the scan list.
+ * All the instances are read in batch on each refresh, while the window is shown.
+ */
+class StructView : public QWidget {
+  Q_OBJECT
+
+public:
+  explicit StructView(MedUi* mainUi);
+  virtual ~StructView();
+
+protected:
+  void showEvent(QShowEvent* event) override;
+  void hideEvent(QHideEvent* event) override;
+
+private slots:
+  void onApplyAddressClicked();
+  void onApplyScanListClicked();
+  void onRefreshTimeout();
+
+private:
+  bool compileTemplate();
+  void apply(const vector<Address>& addresses);
+
+  MedUi* mainUi;
+  StructTemplate structTemplate;
+
+  QPlainTextEdit* templateEdit;
+  QLineEdit* addressLine;
+  QLabel* statusLabel;
+  QTableView* tableView;
+  StructTableModel* model;
+  QTimer* refreshTimer;
+};
+
+#endif
@@ -2,11 +2,13 @@
 #define TREEMODEL_H
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QModelIndex>
 #include <QVariant>
 
 #include "ui/TreeItem.hpp"
 #include "mem/MemEd.hpp"
+#include "mem/ValueCache.hpp"
 
 /**
  * Trying to use the Med instead of TreeItem. But looks like using Med directly instead of TreeItem looks improbable.
@@ -57,11 +59,13 @@ public:
   void appendRow(TreeItem* treeItem);
   void clearAll();
 
-  void addScan(string scanType);
-
-  void refreshValues();
   void empty(); //including the med data
 
+  /**
+   * Show the changed values in a different colour for a while
+   */
+  void setHighlightChanges(bool value);
+
   TreeItem* root();
   MedUi* mainUi;
   MemEd* med;
@@ -69,6 +73,15 @@ public:
 protected:
   void setupModelData(const QStringList &lines, TreeItem* parent);
 
+  /**
+   * Apply the values read by the value cache, only the changed cells are updated.
+   * A value is skipped if its row no longer has the requested address.
+   */
+  void applyValues(const vector<CachedValue>& values, MemList* list, int column);
+  QVariant getHighlight(int row) const;
+  void clearChanges();
+  void emitRowsChanged(const vector<int>& rows, int column);
+
   TreeItem* getItem(const QModelIndex &index) const;
   TreeItem* rootItem;
 
@@ -79,6 +92,10 @@ protected:
   QVariant getUtfString(int row, string scanType);
   string encodeString(const string& str, const string& scanType);
   string convertToUtf8(const string& str, const string& scanType);
+
+  bool highlightChanges;
+  int highlightColumn;
+  QHash<int, qint64> changedAt; // ms since epoch, by row
 };
 
 #endif // TREEMODEL_H
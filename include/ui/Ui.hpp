@@ -4,6 +4,7 @@
 #define SCAN_COL_ADDRESS 0
 #define SCAN_COL_TYPE 1
 #define SCAN_COL_VALUE 2
+#define SCAN_COL_SUGGESTED 3
 
 #define STORE_COL_DESCRIPTION 0
 #define STORE_COL_ADDRESS 1
@@ -17,19 +18,31 @@
 #include <QStatusBar>
 #include <QPlainTextEdit>
 #include <QComboBox>
+#include <QPushButton>
+#include <QSpinBox>
 
 #include "ui/TreeModel.hpp"
+#include "ui/ScanTableModel.hpp"
 #include "ui/StoreTreeModel.hpp"
 #include "ui/NamedScansController.hpp"
 #include "mem/MemEd.hpp"
+#include "mem/WriteTracer.hpp"
+#include "mem/ValueCache.hpp"
+#include "mem/TypeAnalyzer.hpp"
 
 const int REFRESH_RATE = 800;
+const int SCAN_PROGRESS_RATE = 100; // ms
+const int CHANGE_HIGHLIGHT_DURATION = 2000; // ms
+const int TYPE_INFERENCE_RATE = 100; // ms
+const int TYPE_INFERENCE_SAMPLES = 20;
+const int TYPE_INFERENCE_MAX_ADDRESSES = 10000;
 
 const QString MAIN_TITLE = "Med UI";
 
 enum UiState { Idle, Editing };
 
 class EncodingManager; // Forward declaration, because of recursive include
+class QTimer;
 
 class MedUi : public QObject {
   Q_OBJECT
@@ -42,6 +55,8 @@ public:
   QWidget* processSelector;
   QDialog* processDialog; // This is the processSelector container
   QTreeWidget* processTreeWidget;
+  QLineEdit* processFilter;
+  QSpinBox* processMinRss;
   QLineEdit* selectedProcessLine;
   QStatusBar* statusBar;
   QComboBox* scanTypeCombo;
@@ -49,9 +64,11 @@ public:
   QTreeView* storeTreeView;
   QPlainTextEdit* notesArea;
   StoreTreeModel* storeModel;
-  TreeModel* scanModel;
+  ScanTableModel* scanModel;
 
-  static void refresh(MedUi* mainUi);
+  /**
+   * Request the values of the visible rows from the value cache, the values are applied when read
+   */
   void refreshScanTreeView();
   void refreshStoreTreeView();
 
@@ -60,7 +77,7 @@ public:
   bool autoRefresh;
   bool fastScan;
   bool forceResume;
-  std::thread* refreshThread;
+  ValueCache* valueCache;
 
   UiState getScanState();
   void setScanState(UiState);
@@ -74,12 +91,19 @@ public:
   void openFile(QString filename);
   void updateNumberOfAddresses();
 
+signals:
+  void valuesRefreshed(); // Emitted by the value cache thread
+
 public slots:
   void onProcessItemDblClicked(QTreeWidgetItem* item, int column);
+  void onProcessFilterChanged();
 
 private slots:
   void onProcessClicked();
   void onScanClicked();
+  void onScanRecordsTriggered();
+  void onInferTypesTriggered();
+  void onInferTypesTimeout();
   void onFilterClicked();
   void onPauseCheckboxClicked(bool checked);
 
@@ -112,17 +136,27 @@ private slots:
   void onShowNotesTriggered(bool checked);
   void onNotesAreaChanged();
   void onAutoRefreshTriggered(bool checked);
+  void onHighlightChangesTriggered(bool checked);
   void onRefreshTriggered();
   void onResumeProcessTriggered(bool checked);
   void onFastScanTriggered(bool checked);
   void onForceResumeTriggered(bool checked);
+  void onWriteOnlyIfChangedTriggered(bool checked);
   void onUnlockAllTriggered();
+  void onLockIntervalTriggered();
+  void onFindWritesTriggered(bool checked);
+  void onScanProgressTimeout();
+  void onRefreshTimeout();
+  void onValuesRefreshed();
 
   void onNewAddressTriggered();
   void onDeleteAddressTriggered();
   void onStoreClearTriggered();
 
   void onMemEditorTriggered();
+  void onMemDiffTriggered();
+  void onStructViewTriggered();
+  void onSessionPidsTriggered();
 
   void onScopeStartEdited();
   void onScopeEndEdited();
@@ -132,10 +166,18 @@ private:
   void loadProcessUi();
   void loadMemEditor();
   void setupStatusBar();
+  void showScanStats();
   void setupScanTreeView();
   void setupStoreTreeView();
   void setupSignals();
   void setupUi();
+  void setupScanProgress();
+  void startScanProgress(ScanProgressPtr progress);
+  void finishScanProgress();
+  void setScanning(bool scanning);
+  void setupValueCache();
+  void setupTypeInference();
+  vector<ValueRequest> getVisibleRequests(QTreeView* treeView, vector<MemPtr>& list);
 
   string getLastDigit();
 
@@ -143,6 +185,21 @@ private:
   UiState scanState;
   UiState storeState;
   QWidget* memEditor;
+  QWidget* memDiffView;
+  QWidget* structView;
+  WriteTracer* writeTracer;
+
+  QPushButton* scanButton;
+  QPushButton* filterButton;
+  QTimer* scanTimer;
+  QTimer* refreshTimer;
+  QTimer* inferTimer;
+  TypeAnalyzer* typeAnalyzer;
+  ScanProgressPtr scanProgress;
+  string progressScanType;
+  bool isSnapshotSave;
+  bool processExited; // Waiting for the process to restart
+  QString recordScanText;
 
   QString filename;
 
@@ -0,0 +1,394 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <json/json.h>
+
+#include "med/DeltaMatcher.hpp"
+#include "med/MedCommon.hpp"
+#include "med/ScanCommand.hpp"
+#include "mem/Freezer.hpp"
+#include "mem/MemEd.hpp"
+#include "mem/MemScanner.hpp"
+#include "mem/Sem.hpp"
+
+using namespace std;
+
+/**
+ * Benchmark of the scan, filter and IO paths against a synthetic target process.
+ *
+ * The heap is split into one segment per scan type. Each segment is filled by the distribution,
+ * then TARGET_VALUE is planted at "density" of the slots. The process is forked, so that
+ * the target has the same addresses, and all reads and writes cross the process boundary.
+ *
+ * Usage: bench [--heap_mb=24] [--density=0.001] [--distribution=random|small|zero]
+ *              [--repetitions=5] [--filter=substring] [--out=file.json]
+ */
+
+namespace {
+  const int TARGET_VALUE = 100;
+  const size_t STORE_SIZE = 1000;
+
+  struct Options {
+    size_t heapSize = 24 * 1024 * 1024;
+    double density = 0.001;
+    string distribution = "random";
+    int repetitions = 5;
+    string filter = "";
+    string out = "";
+  };
+
+  struct Segment {
+    string scanType;
+    Address start;
+    Address end;
+  };
+
+  struct Result {
+    double median; // ms
+    double min;
+    double mean;
+  };
+
+  const vector<string> SCAN_TYPES = {
+    SCAN_TYPE_INT_8, SCAN_TYPE_INT_16, SCAN_TYPE_INT_32, SCAN_TYPE_INT_64, SCAN_TYPE_FLOAT_32, SCAN_TYPE_FLOAT_64
+  };
+
+  // Scan strings, the "<>" is narrow, so that the matches stay near the density
+  const vector<string> SCAN_OPS = { "100", "<> 95 105" };
+
+  uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  template<typename T>
+  void fillSegment(Byte* start, size_t size, const Options& options, uint64_t& seed) {
+    size_t count = size / sizeof(T);
+    T* values = (T*)start;
+    for (size_t i = 0; i < count; i++) {
+      if (options.distribution == "zero") {
+        values[i] = 0;
+      }
+      else if (options.distribution == "small") {
+        values[i] = (T)(xorshift(seed) % 1000);
+      }
+      else if (std::is_floating_point<T>::value) {
+        values[i] = (T)((xorshift(seed) % 100000000) / 100.0);
+      }
+      else {
+        values[i] = (T)xorshift(seed);
+      }
+    }
+    size_t planted = (size_t)(count * options.density);
+    for (size_t i = 0; i < planted; i++) {
+      values[xorshift(seed) % count] = (T)TARGET_VALUE;
+    }
+  }
+
+  void fillSegment(const Segment& segment, const Options& options, uint64_t& seed) {
+    Byte* start = (Byte*)segment.start;
+    size_t size = segment.end - segment.start;
+    if (segment.scanType == SCAN_TYPE_INT_8) fillSegment<uint8_t>(start, size, options, seed);
+    else if (segment.scanType == SCAN_TYPE_INT_16) fillSegment<uint16_t>(start, size, options, seed);
+    else if (segment.scanType == SCAN_TYPE_INT_32) fillSegment<uint32_t>(start, size, options, seed);
+    else if (segment.scanType == SCAN_TYPE_INT_64) fillSegment<uint64_t>(start, size, options, seed);
+    else if (segment.scanType == SCAN_TYPE_FLOAT_32) fillSegment<float>(start, size, options, seed);
+    else fillSegment<double>(start, size, options, seed);
+  }
+
+  Result measure(int repetitions, const function<void()>& setup, const function<void()>& run) {
+    vector<double> times;
+    for (int i = 0; i < repetitions; i++) {
+      setup();
+      auto start = chrono::steady_clock::now();
+      run();
+      times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    sort(times.begin(), times.end());
+    double sum = 0;
+    for (double t : times) {
+      sum += t;
+    }
+    return Result { times[times.size() / 2], times[0], sum / times.size() };
+  }
+
+  Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+      string arg = argv[i];
+      size_t eq = arg.find('=');
+      string key = arg.substr(0, eq);
+      string value = eq == string::npos ? "" : arg.substr(eq + 1);
+      if (key == "--heap_mb") options.heapSize = stoul(value) * 1024 * 1024;
+      else if (key == "--density") options.density = stod(value);
+      else if (key == "--distribution") options.distribution = value;
+      else if (key == "--repetitions") options.repetitions = std::max(stoi(value), 1);
+      else if (key == "--filter") options.filter = value;
+      else if (key == "--out") options.out = value;
+      else {
+        cerr << "Unknown option " << arg << endl;
+        exit(1);
+      }
+    }
+    return options;
+  }
+
+  class Bench {
+  public:
+    Bench(const Options& options, pid_t pid, const vector<Segment>& segments)
+      : options(options), pid(pid), segments(segments) {}
+
+    void run() {
+      for (auto& segment : segments) {
+        for (auto& op : SCAN_OPS) {
+          benchScanAndFilter(segment, op);
+        }
+        benchSnapshot(segment);
+        benchStore(segment);
+      }
+    }
+
+    Json::Value& getResults() {
+      return results;
+    }
+
+  private:
+    bool selected(const string& name) {
+      return options.filter == "" || name.find(options.filter) != string::npos;
+    }
+
+    void report(const string& name, const Result& result, const string& unit, double amount, size_t items) {
+      Json::Value entry;
+      entry["name"] = name;
+      entry["repetitions"] = options.repetitions;
+      entry["real_time_ms"] = result.median;
+      entry["min_time_ms"] = result.min;
+      entry["mean_time_ms"] = result.mean;
+      entry["items"] = (Json::UInt64)items;
+      if (unit != "") {
+        entry[unit] = result.median > 0 ? amount / (result.median / 1000) : 0;
+      }
+      results.append(entry);
+      fprintf(stderr, "%-44s %10.3f ms %14zu items\n", name.c_str(), result.median, items);
+    }
+
+    void setScope(MemScanner& scanner, const Segment& segment) {
+      scanner.setScopeStart(segment.start);
+      scanner.setScopeEnd(segment.end);
+    }
+
+    vector<MemPtr> scanPlanted(MemScanner& scanner, const Segment& segment) {
+      setScope(scanner, segment);
+      ScanCommand command(to_string(TARGET_VALUE), segment.scanType);
+      return scanner.scan(command, Integers(), true);
+    }
+
+    void benchScanAndFilter(const Segment& segment, const string& op) {
+      string suffix = segment.scanType + "/" + (op.find("<>") == 0 ? "<>" : "=");
+      MemScanner scanner(pid);
+      setScope(scanner, segment);
+      ScanCommand command(op, segment.scanType);
+      vector<MemPtr> list;
+
+      string name = "scan/" + suffix;
+      if (selected(name)) {
+        auto result = measure(options.repetitions, [&list]() { list.clear(); }, [&]() {
+            list = scanner.scan(command, Integers(), true);
+          });
+        report(name, result, "bytes_per_second", segment.end - segment.start, list.size());
+      }
+
+      name = "filter/" + suffix;
+      if (selected(name)) {
+        vector<MemPtr> candidates = scanner.scan(command, Integers(), true);
+        auto result = measure(options.repetitions, []() {}, [&]() {
+            list = scanner.filter(candidates, command);
+          });
+        report(name, result, "items_per_second", candidates.size(), list.size());
+      }
+    }
+
+    void benchSnapshot(const Segment& segment) {
+      MemScanner scanner(pid);
+      setScope(scanner, segment);
+      vector<MemPtr> empty;
+      vector<MemPtr> list;
+      size_t bytes = segment.end - segment.start;
+
+      string name = "snapshot/save/" + segment.scanType;
+      if (selected(name)) {
+        size_t pages = 0;
+        auto result = measure(options.repetitions, []() {}, [&]() {
+            pages = scanner.saveSnapshot(empty).size();
+          });
+        report(name, result, "bytes_per_second", bytes, pages);
+      }
+
+      name = "snapshot/diff/" + segment.scanType + "/!=";
+      if (selected(name)) {
+        auto result = measure(options.repetitions, [&]() { scanner.saveSnapshot(empty); }, [&]() {
+            list = scanner.filterUnknown(empty, segment.scanType, ScanParser::OpType::Neq, true);
+          });
+        report(name, result, "bytes_per_second", bytes, list.size());
+      }
+
+      name = "snapshot/diff/" + segment.scanType + "/+=";
+      if (selected(name)) {
+        DeltaMatcher matcher("+= 1", segment.scanType);
+        auto result = measure(options.repetitions, [&]() { scanner.saveSnapshot(empty); }, [&]() {
+            list = scanner.filterDelta(empty, matcher, true);
+          });
+        report(name, result, "bytes_per_second", bytes, list.size());
+      }
+    }
+
+    /**
+     * Store refresh, and the write of the Freezer, with the planted addresses as the stored entries.
+     * The freeze is measured by writing always, and by writing only if changed, where the values are
+     * either unchanged (read only) or changed before each repetition (read and write).
+     */
+    void benchStore(const Segment& segment) {
+      string refreshName = "store/refresh/" + segment.scanType;
+      string freezeName = "store/freeze/" + segment.scanType;
+      if (!selected(refreshName) && !selected(freezeName)) {
+        return;
+      }
+
+      MemEd med(pid);
+      MemScanner scanner(pid);
+      vector<MemPtr> planted = scanPlanted(scanner, segment);
+      size_t size = scanTypeToSize(segment.scanType);
+      auto& store = med.getStore()->getList();
+      vector<SemPtr> sems;
+      vector<SemPtr> changes; // Other values at the same addresses
+      for (size_t i = 0; i < planted.size() && i < STORE_SIZE; i++) {
+        SemPtr sem = SemPtr(new Sem(planted[i]->getAddress(), size, med.getMemIO()));
+        sem->setScanType(segment.scanType);
+        sem->setLockedValue(to_string(TARGET_VALUE));
+        sem->lock(true);
+        store.push_back(sem);
+        sems.push_back(sem);
+
+        SemPtr change = SemPtr(new Sem(planted[i]->getAddress(), size, med.getMemIO()));
+        change->setScanType(segment.scanType);
+        change->setLockedValue(to_string(TARGET_VALUE + 1));
+        changes.push_back(change);
+      }
+
+      if (selected(refreshName)) {
+        auto result = measure(options.repetitions * 10, []() {}, [&med]() {
+            med.getStore()->getValues();
+          });
+        report(refreshName, result, "items_per_second", store.size(), store.size());
+      }
+
+      // Not started, so that only the measured writes are done
+      Freezer freezer(med.getMemIO());
+      string name = freezeName + "/always";
+      if (selected(name)) {
+        auto result = measure(options.repetitions * 10, []() {}, [&]() {
+            freezer.writeNow(sems);
+          });
+        report(name, result, "items_per_second", sems.size(), sems.size());
+      }
+
+      freezer.setWriteOnlyIfChanged(true);
+      name = freezeName + "/if_changed/unchanged";
+      if (selected(name)) {
+        auto result = measure(options.repetitions * 10, []() {}, [&]() {
+            freezer.writeNow(sems);
+          });
+        report(name, result, "items_per_second", sems.size(), sems.size());
+      }
+
+      name = freezeName + "/if_changed/changed";
+      if (selected(name)) {
+        Freezer changer(med.getMemIO());
+        auto result = measure(options.repetitions * 10, [&]() { changer.writeNow(changes); }, [&]() {
+            freezer.writeNow(sems);
+          });
+        report(name, result, "items_per_second", sems.size(), sems.size());
+      }
+    }
+
+    Options options;
+    pid_t pid;
+    vector<Segment> segments;
+    Json::Value results = Json::Value(Json::arrayValue);
+  };
+}
+
+int main(int argc, char** argv) {
+  Options options = parseOptions(argc, argv);
+
+  size_t pageSize = getpagesize();
+  size_t segmentSize = std::max(options.heapSize / SCAN_TYPES.size() / pageSize, (size_t)1) * pageSize;
+  Byte* heap = (Byte*)mmap(NULL, segmentSize * SCAN_TYPES.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (heap == MAP_FAILED) {
+    cerr << "Failed allocate the heap" << endl;
+    return 1;
+  }
+
+  vector<Segment> segments;
+  uint64_t seed = 88172645463325252ULL;
+  for (size_t i = 0; i < SCAN_TYPES.size(); i++) {
+    Address start = (Address)heap + i * segmentSize;
+    segments.push_back(Segment { SCAN_TYPES[i], start, start + segmentSize });
+    fillSegment(segments.back(), options, seed);
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    for (;;) {
+      pause();
+    }
+  }
+
+  Bench bench(options, pid, segments);
+  bench.run();
+
+  kill(pid, SIGKILL);
+  waitpid(pid, NULL, 0);
+
+  Json::Value root;
+  Json::Value& context = root["context"];
+  char date[64];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+  context["date"] = date;
+  context["num_cpus"] = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  context["heap_bytes"] = (Json::UInt64)(segmentSize * SCAN_TYPES.size());
+  context["density"] = options.density;
+  context["distribution"] = options.distribution;
+  context["repetitions"] = options.repetitions;
+  root["benchmarks"] = bench.getResults();
+
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "  ";
+  string json = Json::writeString(builder, root);
+  if (options.out != "") {
+    ofstream file(options.out);
+    file << json << endl;
+  }
+  else {
+    cout << json << endl;
+  }
+  return 0;
+}
@@ -4,6 +4,8 @@
 #include <vector>
 #include <readline/readline.h>
 #include <readline/history.h>
+#include <chrono>
+#include <thread>
 
 // For segment fault tracing
 #include <execinfo.h>
@@ -13,10 +15,22 @@
 #include "mem/StringUtil.hpp"
 #include "mem/MemScanner.hpp"
 #include "mem/MemEd.hpp"
+#include "mem/WriteTracer.hpp"
+#include "mem/MemDiff.hpp"
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
 
 #define COMMAND_SCAN 1
 #define COMMAND_FILTER 2
 #define COMMAND_LIST 3
+#define COMMAND_TRACE_WRITES 4
+#define COMMAND_PROFILE 5
+#define COMMAND_STATS 6
+#define COMMAND_DIFF 7
+#define COMMAND_RECORDS 8
+#define COMMAND_TREE 9
+
+const int DEFAULT_DURATION_SECONDS = 5;
 
 using namespace std;
 
@@ -24,10 +38,17 @@ int const PROMPT_BUFFER = 255;
 
 pid_t g_pid;
 MemEd* memed;
+MemSnapshot g_snapshot;
 
 int interpretCommand(const string& command) {
   if (command == "s") return COMMAND_SCAN;
   else if (command == "f") return COMMAND_FILTER;
+  else if (command == "w") return COMMAND_TRACE_WRITES;
+  else if (command == "p") return COMMAND_PROFILE;
+  else if (command == "stats") return COMMAND_STATS;
+  else if (command == "d") return COMMAND_DIFF;
+  else if (command == "r") return COMMAND_RECORDS;
+  else if (command == "t") return COMMAND_TREE;
   return COMMAND_LIST;
 }
 
@@ -37,8 +58,110 @@ void scan(const string& value) {
 }
 
 void filter(const string& value) {
+  MemIO* memio = memed->getMemIO();
+  memio->resetStats();
   vector<MemPtr> mems = memed->filter(value, "int32");
-  printf("Filtered %zu\n", mems.size());
+  MemIOStats stats = memio->getStats();
+  printf("Filtered %zu (read %zu bytes for %zu bytes needed, %zu syscalls)\n",
+         mems.size(), stats.bytesRead, stats.bytesNeeded, stats.syscalls);
+}
+
+/**
+ * Trace the writes to the int32 at the address for some seconds
+ */
+void traceWrites(const string& address, int seconds) {
+  WriteTracer tracer(g_pid);
+  try {
+    tracer.start(hexToInt(address), 4);
+  } catch (MedException& e) {
+    printf("%s\n", e.what());
+    return;
+  }
+  printf("Tracing writes to %s for %d seconds\n", address.c_str(), seconds);
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  tracer.stop();
+
+  auto hits = tracer.getHits();
+  for (auto& hit : hits) {
+    printf("%zu\t%s\n", hit.count, hit.location.c_str());
+  }
+  printf("Found %zu instructions\n", hits.size());
+}
+
+/**
+ * Profile the change rate for some seconds, and print the heat map, one character per page.
+ */
+void profile(int seconds) {
+  const string heat = " .:-=+*#%@";
+  const size_t pagesPerLine = 64;
+
+  ChangeProfiler* profiler = memed->getChangeProfiler();
+  profiler->clear();
+  profiler->start();
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  profiler->stop();
+
+  auto heatMap = profiler->getHeatMap();
+  size_t pageSize = getpagesize();
+  string line;
+  Address lineStart = 0;
+  for (size_t i = 0; i < heatMap.size(); i++) {
+    auto& page = heatMap[i];
+    bool contiguous = i > 0 && heatMap[i - 1].address + pageSize == page.address;
+    if (line.size() > 0 && (!contiguous || line.size() == pagesPerLine)) {
+      printf("%s |%s|\n", intToHex(lineStart).c_str(), line.c_str());
+      line = "";
+    }
+    if (line.size() == 0) {
+      lineStart = page.address;
+    }
+    line += heat[std::min((size_t)(page.rate * (heat.size() - 1) + 0.5), heat.size() - 1)];
+  }
+  if (line.size() > 0) {
+    printf("%s |%s|\n", intToHex(lineStart).c_str(), line.c_str());
+  }
+
+  auto ranges = profiler->getVolatileRanges();
+  for (auto& range : ranges) {
+    printf("Volatile %s-%s\n", intToHex(range.first).c_str(), intToHex(range.second).c_str());
+  }
+  printf("Profiled %zu pages, %zu volatile ranges\n", heatMap.size(), ranges.size());
+}
+
+/**
+ * The first call takes the snapshot of the region, then each call prints the changes since the previous call
+ */
+void diff(const string& address, size_t size, const string& scanType) {
+  MemDiff memDiff(memed->getMemIO());
+  Address start = hexToInt(address);
+  if (g_snapshot.address != start || g_snapshot.data.size() != size) {
+    g_snapshot = memDiff.take(start, size);
+    printf("Snapshot %s, %zu bytes\n", address.c_str(), size);
+    return;
+  }
+
+  MemSnapshot after;
+  auto ranges = memDiff.compareLive(g_snapshot, after);
+  for (auto& range : ranges) {
+    for (auto& value : MemDiff::interpret(g_snapshot, after, range, scanType)) {
+      printf("%s\t+%lx\t%s -> %s\n", intToHex(value.address).c_str(), value.address - start,
+             value.before.c_str(), value.after.c_str());
+    }
+  }
+  printf("Changed %zu ranges\n", ranges.size());
+  g_snapshot = after;
+}
+
+/**
+ * Scan the arrays of the records, such as "r 16 10 0x0 int32 <> 1 999; 0x8 float32 > 0"
+ */
+void scanRecords(size_t stride, size_t minRecords, const string& predicates) {
+  try {
+    vector<MemPtr> mems = memed->scanRecords(predicates, stride, minRecords);
+    printf("Scanned %zu records\n", mems.size());
+  } catch (MedException& e) {
+    printf("%s\n", e.what());
+  }
 }
 
 void showList() {
@@ -62,6 +185,40 @@ void interpretLine(string command) {
   else if (cmd == COMMAND_FILTER) {
     filter(splitted[1]);
   }
+  else if (cmd == COMMAND_STATS) {
+    printf("%s\n", memed->getScanStats().toString().c_str());
+  }
+  else if (cmd == COMMAND_PROFILE) {
+    if (splitted.size() > 1 && splitted[1] == "skip") {
+      memed->setSkipVolatile(true);
+    }
+    else if (splitted.size() > 1 && splitted[1] == "noskip") {
+      memed->setSkipVolatile(false);
+    }
+    else {
+      profile(splitted.size() > 1 ? stoi(splitted[1]) : DEFAULT_DURATION_SECONDS);
+    }
+  }
+  else if (cmd == COMMAND_DIFF) {
+    diff(splitted[1], splitted.size() > 2 ? stoul(splitted[2]) : 4096, splitted.size() > 3 ? splitted[3] : "int32");
+  }
+  else if (cmd == COMMAND_RECORDS && splitted.size() > 3) {
+    string predicates;
+    for (size_t i = 3; i < splitted.size(); i++) {
+      predicates += splitted[i] + " ";
+    }
+    scanRecords(stoul(splitted[1]), stoul(splitted[2]), predicates);
+  }
+  else if (cmd == COMMAND_TREE) {
+    memed->addProcessTree();
+    for (auto pid : memed->getSessionPids()) {
+      printf("%d ", pid);
+    }
+    printf("\n");
+  }
+  else if (cmd == COMMAND_TRACE_WRITES) {
+    traceWrites(splitted[1], splitted.size() > 2 ? stoi(splitted[2]) : DEFAULT_DURATION_SECONDS);
+  }
   else {
     showList();
   }
@@ -81,13 +238,32 @@ void handler(int sig) {
 int main(int argc, char** argv) {
   if (argc < 2) {
     cerr << "Missing argument\n"
-      "Usage: med-cli [pid]" << endl;
+      "Usage: med-cli [pid|name]" << endl;
     return -1;
   }
   signal(SIGSEGV, handler);
 
-  g_pid = stol(string(argv[1]));
-  memed = new MemEd(g_pid);
+  string target = argv[1];
+  if (target.find_first_not_of("0123456789") == string::npos) {
+    g_pid = stol(target);
+    memed = new MemEd();
+    memed->listProcesses();
+    try {
+      memed->selectProcess(target); // Watched for restart
+    } catch (MedException& e) {
+      memed->setPid(g_pid);
+    }
+  } else { // The largest process of the name, such as the game rather than its launcher
+    memed = new MemEd();
+    Process process = memed->selectLargestProcess(target);
+    if (process.pid == "") {
+      cerr << "No process matches " << target << endl;
+      delete memed;
+      return -1;
+    }
+    g_pid = stol(process.pid);
+    cout << "Selected " << process.pid << " " << process.cmdline << endl;
+  }
 
   char shellPrompt[PROMPT_BUFFER];
   cout << "Med CLI" <<endl;
@@ -99,6 +275,14 @@ int main(int argc, char** argv) {
     if (!input) break;
     add_history(input);
 
+    size_t numOfUnlocked;
+    if (memed->reattachIfRestarted(&numOfUnlocked)) {
+      g_pid = memed->getPid();
+      cout << "Re-attached to " << memed->selectedProcess.pid << " " << memed->selectedProcess.cmdline << endl;
+      if (numOfUnlocked > 0) {
+        cout << "Unlocked " << numOfUnlocked << " values outside the modules" << endl;
+      }
+    }
     interpretLine(string(input));
 
     free(input);
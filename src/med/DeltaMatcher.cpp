@@ -0,0 +1,121 @@
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "med/BlockMask.hpp"
+#include "med/DeltaMatcher.hpp"
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "med/ScanParser.hpp"
+
+using namespace std;
+
+namespace {
+  // The integers are read unsigned, but the values are signed
+  template<typename T>
+  double signedValue(T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+      return (double)value;
+    }
+    else {
+      return (double)(typename std::make_signed<T>::type)value;
+    }
+  }
+
+  template<typename T>
+  double delta(T newValue, T oldValue) {
+    if constexpr (std::is_floating_point<T>::value) {
+      return (double)newValue - (double)oldValue;
+    }
+    else {
+      return (double)(typename std::make_signed<T>::type)(T)(newValue - oldValue);
+    }
+  }
+}
+
+DeltaMatcher::DeltaMatcher(const string& value, const string& scanType) {
+  this->scanType = stringToScanType(scanType);
+  if (this->scanType == ScanType::String ||
+      this->scanType == ScanType::Custom ||
+      this->scanType == ScanType::Unknown) {
+    throw MedException("Delta filter only supports numeric type");
+  }
+
+  op = ScanParser::getOpType(value);
+  if (!ScanParser::isDeltaOperator(op)) {
+    throw MedException("Not a delta operator: " + value);
+  }
+
+  vector<string> values = ScanParser::getValues(value, ' ');
+  if (values.size() < 1) {
+    throw MedException("Delta filter requires a value");
+  }
+  low = stod(values[0]);
+  high = values.size() < 2 ? low : stod(values[1]);
+  if (low > high) {
+    std::swap(low, high);
+  }
+}
+
+ScanType DeltaMatcher::getScanType() {
+  return scanType;
+}
+
+size_t DeltaMatcher::getSize() {
+  return scanTypeToSize(scanType);
+}
+
+template<typename T>
+size_t DeltaMatcher::matchBlockOf(const Byte* newBlock, const Byte* oldBlock, size_t count, size_t step, Byte* mask) const {
+  const double low = this->low;
+  const double high = this->high;
+  const double ratio = this->low / 100.0;
+
+  switch (op) {
+  case ScanParser::OpType::IncreasedBy:
+    return BlockMask::fill<T>(newBlock, oldBlock, count, step, mask, [low, high](T n, T o) {
+        double d = delta(n, o);
+        return (d >= low) & (d <= high);
+      });
+  case ScanParser::OpType::DecreasedBy:
+    return BlockMask::fill<T>(newBlock, oldBlock, count, step, mask, [low, high](T n, T o) {
+        double d = -delta(n, o);
+        return (d >= low) & (d <= high);
+      });
+  case ScanParser::OpType::ChangedByPercent:
+    return BlockMask::fill<T>(newBlock, oldBlock, count, step, mask, [ratio](T n, T o) {
+        double d = std::fabs(delta(n, o));
+        return (d == 0) | (d < ratio * std::fabs(signedValue(o)));
+      });
+  default:
+    memset(mask, 0, count);
+    return 0;
+  }
+}
+
+size_t DeltaMatcher::matchBlock(const Byte* newBlock, const Byte* oldBlock, size_t count, size_t step, Byte* mask) const {
+  switch (scanType) {
+  case Int8:
+    return matchBlockOf<uint8_t>(newBlock, oldBlock, count, step, mask);
+  case Int16:
+    return matchBlockOf<uint16_t>(newBlock, oldBlock, count, step, mask);
+  case Int32:
+  case Ptr32:
+    return matchBlockOf<uint32_t>(newBlock, oldBlock, count, step, mask);
+  case Int64:
+  case Ptr64:
+    return matchBlockOf<uint64_t>(newBlock, oldBlock, count, step, mask);
+  case Float32:
+    return matchBlockOf<float>(newBlock, oldBlock, count, step, mask);
+  case Float64:
+    return matchBlockOf<double>(newBlock, oldBlock, count, step, mask);
+  default:
+    memset(mask, 0, count);
+    return 0;
+  }
+}
+
+bool DeltaMatcher::match(const Byte* newValue, const Byte* oldValue) const {
+  Byte mask;
+  return matchBlock(newValue, oldValue, 1, 0, &mask) > 0;
+}
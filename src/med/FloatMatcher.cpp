@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "med/BlockMask.hpp"
+#include "med/FloatMatcher.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+namespace {
+  double operandToDouble(SizedBytes operand, ScanType scanType) {
+    if (scanType == Float32) {
+      return BlockMask::readValue<float>(operand.getBytes());
+    }
+    return BlockMask::readValue<double>(operand.getBytes());
+  }
+
+  template<typename I>
+  int64_t orderedDistance(I a, I b) {
+    // Map sign-magnitude to two's complement, so that adjacent floats are adjacent integers
+    if (a < 0) a = numeric_limits<I>::min() - a;
+    if (b < 0) b = numeric_limits<I>::min() - b;
+    uint64_t diff = a > b ? (uint64_t)a - (uint64_t)b : (uint64_t)b - (uint64_t)a;
+    if (diff > (uint64_t)numeric_limits<int64_t>::max()) {
+      return numeric_limits<int64_t>::max();
+    }
+    return (int64_t)diff;
+  }
+}
+
+FloatMatcher::FloatMatcher() {
+  scanType = ScanType::Float32;
+  op = ScanParser::OpType::Eq;
+  first = 0;
+  second = 0;
+  ulps = 0;
+}
+
+FloatMatcher::FloatMatcher(ScanType scanType, Operands& operands, const ScanParser::OpType& op) {
+  if (!isFloatType(scanType)) {
+    throw MedException("FloatMatcher: not a float type");
+  }
+  this->scanType = scanType;
+  this->op = op;
+  first = operandToDouble(operands.getFirstOperand(), scanType);
+  second = first;
+  ulps = 0;
+
+  if (op == ScanParser::OpType::Within || op == ScanParser::OpType::Around) {
+    second = operandToDouble(operands.getSecondOperand(), scanType);
+  }
+  else if (op == ScanParser::OpType::AroundUlp) {
+    ulps = BlockMask::readValue<int64_t>(operands.getSecondOperand().getBytes());
+  }
+}
+
+bool FloatMatcher::isFloatType(ScanType scanType) {
+  return scanType == ScanType::Float32 || scanType == ScanType::Float64;
+}
+
+int64_t FloatMatcher::ulpDistance(float a, float b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return numeric_limits<int64_t>::max();
+  }
+  int32_t ia, ib;
+  memcpy(&ia, &a, sizeof(float));
+  memcpy(&ib, &b, sizeof(float));
+  return orderedDistance(ia, ib);
+}
+
+int64_t FloatMatcher::ulpDistance(double a, double b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return numeric_limits<int64_t>::max();
+  }
+  int64_t ia, ib;
+  memcpy(&ia, &a, sizeof(double));
+  memcpy(&ib, &b, sizeof(double));
+  return orderedDistance(ia, ib);
+}
+
+template<typename T>
+bool FloatMatcher::matchValue(T value) const {
+  switch (op) {
+  case ScanParser::OpType::Eq:
+    return value == first;
+  case ScanParser::OpType::Neq:
+    return value != first;
+  case ScanParser::OpType::Gt:
+    return value > first;
+  case ScanParser::OpType::Lt:
+    return value < first;
+  case ScanParser::OpType::Ge:
+    return value >= first;
+  case ScanParser::OpType::Le:
+    return value <= first;
+  case ScanParser::OpType::Within:
+  case ScanParser::OpType::Around:
+    return value >= first && value <= second;
+  case ScanParser::OpType::AroundUlp:
+    return ulpDistance(value, (T)first) <= ulps;
+  case ScanParser::OpType::Rounded:
+    return std::round(value) == first;
+  case ScanParser::OpType::Truncated:
+    return std::trunc(value) == first;
+  default:
+    return false;
+  }
+}
+
+bool FloatMatcher::match(const Byte* address) const {
+  if (scanType == ScanType::Float32) {
+    return matchValue(BlockMask::readValue<float>(address));
+  }
+  return matchValue(BlockMask::readValue<double>(address));
+}
+
+template<typename T>
+size_t FloatMatcher::matchBlockOf(const Byte* block, size_t count, size_t step, Byte* mask) const {
+  const T value = (T)first;
+  const T low = (T)first;
+  const T high = (T)second;
+  const double target = first;
+
+  switch (op) {
+  case ScanParser::OpType::Eq:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v == value; });
+  case ScanParser::OpType::Neq:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v != value; });
+  case ScanParser::OpType::Gt:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v > value; });
+  case ScanParser::OpType::Lt:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v < value; });
+  case ScanParser::OpType::Ge:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v >= value; });
+  case ScanParser::OpType::Le:
+    return BlockMask::fill<T>(block, count, step, mask, [value](T v) { return v <= value; });
+  case ScanParser::OpType::Within:
+  case ScanParser::OpType::Around:
+    return BlockMask::fill<T>(block, count, step, mask, [low, high](T v) { return (v >= low) & (v <= high); });
+  case ScanParser::OpType::Rounded:
+    return BlockMask::fill<T>(block, count, step, mask, [target](T v) { return std::round(v) == target; });
+  case ScanParser::OpType::Truncated:
+    return BlockMask::fill<T>(block, count, step, mask, [target](T v) { return std::trunc(v) == target; });
+  default:
+    return BlockMask::fill<T>(block, count, step, mask, [this](T v) { return matchValue(v); });
+  }
+}
+
+size_t FloatMatcher::matchBlock(const Byte* block, size_t count, size_t step, Byte* mask) const {
+  if (scanType == ScanType::Float32) {
+    return matchBlockOf<float>(block, count, step, mask);
+  }
+  return matchBlockOf<double>(block, count, step, mask);
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <cstring> //strerror()
@@ -182,7 +183,7 @@ void printHex(FILE* file,void* addr,int size) {
   }
 }
 
-Maps getMaps(pid_t pid) {
+Maps getMaps(pid_t pid, bool writableOnly) {
   Maps maps;
 
   //Get the region from /proc/pid/maps
@@ -191,8 +192,7 @@ Maps getMaps(pid_t pid) {
   FILE* file;
   file = fopen(filename,"r");
   if(!file) {
-    printf("Failed open maps: %s\n",filename);
-    exit(1);
+    throw MedException(string("Failed open maps: ") + filename);
   }
 
   char useless[64];
@@ -215,7 +215,7 @@ Maps getMaps(pid_t pid) {
       continue;
     }
 
-    if (rd == 'r' && wr == 'w' && ((end - start) > 0)) {
+    if (rd == 'r' && (wr == 'w' || !writableOnly) && ((end - start) > 0)) {
       AddressPair pair(start, end);
       maps.push(pair);
     }
@@ -226,6 +226,73 @@ Maps getMaps(pid_t pid) {
   return maps;
 }
 
+vector<Module> parseModules(const string& maps) {
+  vector<Module> modules;
+  istringstream stream(maps);
+  string line;
+  while (getline(stream, line)) {
+    Address start, end;
+    int pathIndex = -1;
+    if (sscanf(line.c_str(), "%lx-%lx %*s %*s %*s %*s %n", &start, &end, &pathIndex) < 2 || pathIndex < 0) {
+      continue;
+    }
+    string name = StringUtil::trim(line.substr(pathIndex));
+    if (name.empty() || name[0] != '/') { // Anonymous, [heap], [stack], etc.
+      continue;
+    }
+
+    if (modules.size() > 0 && modules.back().name == name) {
+      modules.back().start = std::min(modules.back().start, start);
+      modules.back().end = std::max(modules.back().end, end);
+      continue;
+    }
+    modules.push_back(Module { name, start, end });
+  }
+  return modules;
+}
+
+vector<Module> getModules(pid_t pid) {
+  ifstream file("/proc/" + to_string(pid) + "/maps");
+  if (!file) {
+    throw MedException("Failed open maps of " + to_string(pid));
+  }
+  stringstream content;
+  content << file.rdbuf();
+  return parseModules(content.str());
+}
+
+Address relocateAddress(Address address, const vector<Module>& from, const vector<Module>& to, bool* relocated) {
+  if (relocated) {
+    *relocated = false;
+  }
+  for (auto& module : from) {
+    if (address < module.start || address >= module.end) {
+      continue;
+    }
+    for (auto& target : to) {
+      if (target.name == module.name) {
+        if (relocated) {
+          *relocated = true;
+        }
+        return target.start + (address - module.start);
+      }
+    }
+    break;
+  }
+  return address;
+}
+
+string addressToModuleOffset(const vector<Module>& modules, Address address) {
+  for (auto& module : modules) {
+    if (address >= module.start && address < module.end) {
+      char offset[32];
+      snprintf(offset, sizeof(offset), "+0x%lx", address - module.start);
+      return module.name.substr(module.name.find_last_of('/') + 1) + offset;
+    }
+  }
+  return intToHex(address);
+}
+
 /**
  * Open the /proc/[pid]/mem
  * @return file descriptor
@@ -283,9 +350,8 @@ bool isPidSuspended(pid_t pid) {
   sprintf(filename, "/proc/%d/stat", pid);
   FILE* file;
   file = fopen(filename, "r");
-  if (!file) {
-    printf("Failed open stat: %s\n", filename);
-    exit(1);
+  if (!file) { // Exited
+    return false;
   }
   char line[256];
   fgets(line, 255, file);
@@ -317,50 +383,18 @@ int padWordSize(int x) {
 }
 
 /**
- * Get the list of PID
- * This is done by accessing the /proc and /proc/PID and /proc/PID/cmdline
- * The list suppose to be in the descending order
- */
-vector<Process> pidList() {
-  //Get directories
-  vector<Process> pids;
-
-  DIR *d;
-  struct dirent *dir;
-  d = opendir("/proc");
-  if (d) {
-    while ((dir = readdir(d)) != NULL) {
-      if (isdigit(dir->d_name[0])) {
-        string cmd = pidName(dir->d_name);
-        if (cmd.length()) {
-          Process proc;
-          proc.pid = dir->d_name;
-          proc.cmdline = cmd;
-          pids.push_back(proc);
-        }
-
-      }
-    }
-    closedir(d);
-  }
-  return pids;
-}
-
-
-
-/**
- * Get the cmdline from PID
+ * Get the cmdline from PID, the arguments are separated by space
  */
 string pidName(const string& pid) {
-  string ret;
-  ifstream ifile;
-  ifile.open(string("/proc/") + pid + "/cmdline");
-  if(ifile.fail()) {
+  ifstream ifile(string("/proc/") + pid + "/cmdline");
+  if (ifile.fail()) {
     return "";
   }
-  getline(ifile, ret);
-  ifile.close();
-
+  string ret((istreambuf_iterator<char>(ifile)), istreambuf_iterator<char>());
+  while (ret.length() && ret.back() == '\0') {
+    ret.pop_back();
+  }
+  replace(ret.begin(), ret.end(), '\0', ' ');
   return ret;
 }
 
@@ -155,12 +155,12 @@ bool memCompare(const void* ptr1, size_t size1, const void* ptr2, size_t size2,
 }
 
 bool memCompare(const void* ptr, size_t size, Operands& operands, const ScanParser::OpType& op) {
-  SizedBytes firstOperand = operands.getFirstOperand();
-  if (op != ScanParser::Within && op != ScanParser::Around) {
+  SizedBytes& firstOperand = operands.getFirstOperand();
+  if (op != ScanParser::Within && op != ScanParser::Around && op != ScanParser::AroundUlp) {
     return memCompare(ptr, firstOperand.getBytes(), size, op);
   }
 
-  SizedBytes secondOperand = operands.getSecondOperand();
+  SizedBytes& secondOperand = operands.getSecondOperand();
   return memWithin(ptr, firstOperand.getBytes(), secondOperand.getBytes(), size);
 }
 
@@ -9,7 +9,7 @@ size_t Operands::count() {
   return data.size();
 }
 
-SizedBytes Operands::getFirstOperand() {
+SizedBytes& Operands::getFirstOperand() {
   auto size = count();
   if (size < 1) {
     throw MedException("Operands size should not less than 1");
@@ -17,7 +17,7 @@ SizedBytes Operands::getFirstOperand() {
   return data[0];
 };
 
-SizedBytes Operands::getSecondOperand() {
+SizedBytes& Operands::getSecondOperand() {
   auto size = count();
   if (size < 2) {
     throw MedException("Operands size should not less than 2");
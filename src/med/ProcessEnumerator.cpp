@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "med/ProcessEnumerator.hpp"
+
+using namespace std;
+
+namespace {
+  /**
+   * Read the small file in one system call, which is cheaper than a stream for thousands of processes
+   */
+  string readProcFile(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return "";
+    }
+    char buffer[4096];
+    ssize_t size = read(fd, buffer, sizeof(buffer));
+    close(fd);
+    return size > 0 ? string(buffer, size) : "";
+  }
+
+  /**
+   * The arguments are separated by NUL
+   */
+  string readCmdline(const string& pid) {
+    string cmdline = readProcFile("/proc/" + pid + "/cmdline");
+    while (cmdline.length() && cmdline.back() == '\0') {
+      cmdline.pop_back();
+    }
+    replace(cmdline.begin(), cmdline.end(), '\0', ' ');
+    return cmdline;
+  }
+
+  string readExe(const string& pid) {
+    char buffer[4096];
+    ssize_t size = readlink(("/proc/" + pid + "/exe").c_str(), buffer, sizeof(buffer));
+    return size > 0 ? string(buffer, size) : "";
+  }
+
+  string toLower(string text) {
+    transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text;
+  }
+}
+
+bool ProcessEnumerator::parseStat(const string& stat, Process& process) {
+  size_t begin = stat.find('(');
+  size_t end = stat.rfind(')');
+  if (begin == string::npos || end == string::npos || end < begin) {
+    return false;
+  }
+  process.comm = stat.substr(begin + 1, end - begin - 1);
+
+  // Fields after the comm: state (3), ppid (4), ..., starttime (22), vsize (23), rss (24)
+  char state;
+  int ppid;
+  unsigned long long startTime;
+  long rss;
+  int count = sscanf(stat.c_str() + end + 1,
+                     " %c %d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu %*u %ld",
+                     &state, &ppid, &startTime, &rss);
+  if (count != 4) {
+    return false;
+  }
+  static const long pageSize = sysconf(_SC_PAGESIZE);
+  process.ppid = ppid;
+  process.startTime = startTime;
+  process.rss = rss > 0 ? rss * pageSize : 0;
+  return true;
+}
+
+void ProcessEnumerator::refresh() {
+  map<pid_t, Process> latest;
+  DIR* d = opendir("/proc");
+  if (!d) {
+    cache.clear();
+    return;
+  }
+  struct dirent* dir;
+  while ((dir = readdir(d)) != NULL) {
+    if (!isdigit(dir->d_name[0])) {
+      continue;
+    }
+    string pid = dir->d_name;
+    Process process;
+    if (!parseStat(readProcFile("/proc/" + pid + "/stat"), process)) {
+      continue; // Exited
+    }
+    process.pid = pid;
+
+    auto it = cache.find(stoi(pid));
+    if (it != cache.end() && it->second.startTime == process.startTime && it->second.comm == process.comm) { // Not exec'ed
+      process.cmdline = it->second.cmdline;
+      process.exe = it->second.exe;
+    } else {
+      process.cmdline = readCmdline(pid);
+      process.exe = readExe(pid);
+    }
+    latest[stoi(pid)] = process;
+  }
+  closedir(d);
+  cache.swap(latest);
+}
+
+vector<Process> ProcessEnumerator::getProcesses() {
+  return filter("");
+}
+
+vector<Process> ProcessEnumerator::filter(const string& name, size_t minRss) {
+  string lowerName = toLower(name);
+  vector<Process> processes;
+  for (auto& pair : cache) {
+    const Process& process = pair.second;
+    if (process.cmdline.length() == 0 || process.rss < minRss) {
+      continue;
+    }
+    if (lowerName.length() &&
+        toLower(process.comm).find(lowerName) == string::npos &&
+        toLower(process.cmdline).find(lowerName) == string::npos &&
+        toLower(process.exe).find(lowerName) == string::npos) {
+      continue;
+    }
+    processes.push_back(process);
+  }
+  return processes;
+}
+
+vector<Process> ProcessEnumerator::getLargest(size_t count, const string& name) {
+  vector<Process> processes = filter(name);
+  stable_sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) {
+      return a.rss > b.rss;
+    });
+  if (processes.size() > count) {
+    processes.resize(count);
+  }
+  return processes;
+}
+
+vector<pid_t> ProcessEnumerator::getTree(pid_t root) {
+  map<pid_t, vector<pid_t>> children;
+  for (auto& pair : cache) {
+    children[pair.second.ppid].push_back(pair.first);
+  }
+
+  vector<pid_t> tree = { root };
+  for (size_t i = 0; i < tree.size(); i++) {
+    for (auto child : children[tree[i]]) {
+      tree.push_back(child);
+    }
+  }
+  return tree;
+}
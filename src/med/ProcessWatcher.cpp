@@ -0,0 +1,194 @@
+#include <cstdio>
+#include <fstream>
+
+#include <poll.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "med/MedException.hpp"
+#include "med/ProcessWatcher.hpp"
+
+using namespace std;
+
+ProcessWatcher::ProcessWatcher() {
+  pidfd = -1;
+  exited = false;
+  exitTime = 0;
+  restarted = false;
+  thread = NULL;
+  running = false;
+}
+
+ProcessWatcher::~ProcessWatcher() {
+  stop();
+}
+
+void ProcessWatcher::watch(const Process& process) {
+  stop();
+  if (process.pid == "") {
+    return;
+  }
+
+  this->process = process;
+  modules.clear();
+  modulesTime = Clock::time_point();
+  exited = false;
+  restarted = false;
+  newProcess = Process();
+  openPidfd();
+
+  running = true;
+  thread = new std::thread(&ProcessWatcher::run, this);
+}
+
+void ProcessWatcher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      return;
+    }
+    running = false;
+  }
+  cv.notify_all();
+  thread->join();
+  delete thread;
+  thread = NULL;
+  closePidfd();
+}
+
+bool ProcessWatcher::isExited() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return exited;
+}
+
+bool ProcessWatcher::takeRestart(Process& process, vector<Module>& modules) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!restarted) {
+    return false;
+  }
+  process = newProcess;
+  modules = oldModules;
+  restarted = false;
+  return true;
+}
+
+bool ProcessWatcher::isNewInstance(const Process& process, const Process& candidate) {
+  // Also rejects the other processes of the same exe, which are running before it
+  if (candidate.startTime <= process.startTime) {
+    return false;
+  }
+  if (process.exe.length() > 0) {
+    return candidate.exe == process.exe;
+  }
+  return process.cmdline.length() > 0 && candidate.cmdline == process.cmdline;
+}
+
+void ProcessWatcher::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    bool wasExited = exited;
+    lock.unlock();
+
+    if (!wasExited) {
+      bool gone = hasExited();
+      auto now = Clock::now();
+      vector<Module> latest;
+      bool refreshed = false;
+      if (!gone && now - modulesTime >= chrono::milliseconds(MODULE_REFRESH_INTERVAL)) {
+        try {
+          latest = getModules(stoi(process.pid));
+          refreshed = true;
+        } catch (MedException& e) {
+          gone = true;
+        }
+      }
+
+      lock.lock();
+      if (refreshed) {
+        modules = latest;
+        modulesTime = now;
+      }
+      if (gone) {
+        exited = true;
+        foundTime = Clock::time_point();
+        // The exit is seen within an interval
+        unsigned long long interval = WATCH_INTERVAL * sysconf(_SC_CLK_TCK) / 1000;
+        unsigned long long ticks = ticksAfterBoot();
+        exitTime = ticks > interval ? ticks - interval : 0;
+      }
+    } else {
+      // The newest instance, in case the launcher starts several before settling
+      Process found;
+      enumerator.refresh();
+      for (auto& candidate : enumerator.getProcesses()) {
+        if (isNewInstance(process, candidate) && candidate.startTime >= exitTime &&
+            candidate.startTime >= found.startTime) {
+          found = candidate;
+        }
+      }
+
+      lock.lock();
+      if (found.pid == "") {
+        foundTime = Clock::time_point();
+      } else if (found.pid != newProcess.pid || foundTime == Clock::time_point()) {
+        newProcess = found;
+        foundTime = Clock::now();
+      } else if (Clock::now() - foundTime >= chrono::milliseconds(RESTART_SETTLE_TIME)) {
+        oldModules = modules;
+        restarted = true;
+        process = newProcess;
+        modules.clear();
+        modulesTime = Clock::time_point();
+        exited = false;
+        lock.unlock();
+        closePidfd();
+        openPidfd();
+        lock.lock();
+      }
+    }
+
+    cv.wait_for(lock, chrono::milliseconds(WATCH_INTERVAL), [this] { return !running; });
+  }
+}
+
+unsigned long long ProcessWatcher::ticksAfterBoot() {
+  double uptime = 0;
+  ifstream file("/proc/uptime");
+  file >> uptime;
+  return (unsigned long long)(uptime * sysconf(_SC_CLK_TCK));
+}
+
+/**
+ * The pidfd is readable once the process exits. Without it, the process is gone if its stat is
+ * gone, or the pid is reused by another process.
+ */
+bool ProcessWatcher::hasExited() {
+  if (pidfd >= 0) {
+    struct pollfd fd = { pidfd, POLLIN, 0 };
+    return poll(&fd, 1, 0) > 0;
+  }
+  Process current;
+  FILE* file = fopen(("/proc/" + process.pid + "/stat").c_str(), "r");
+  if (!file) {
+    return true;
+  }
+  char line[1024];
+  bool parsed = fgets(line, sizeof(line), file) && ProcessEnumerator::parseStat(line, current);
+  fclose(file);
+  return !parsed || current.startTime != process.startTime;
+}
+
+void ProcessWatcher::openPidfd() {
+#ifdef SYS_pidfd_open
+  pidfd = syscall(SYS_pidfd_open, stoi(process.pid), 0);
+#else
+  pidfd = -1;
+#endif
+}
+
+void ProcessWatcher::closePidfd() {
+  if (pidfd >= 0) {
+    close(pidfd);
+    pidfd = -1;
+  }
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <utility>
+
+#include "med/RecordMatcher.hpp"
+#include "med/BlockMask.hpp"
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "med/ScanParser.hpp"
+#include "mem/StringUtil.hpp"
+
+using namespace std;
+
+namespace {
+  bool isRecordOperator(ScanParser::OpType op) {
+    return op == ScanParser::Eq ||
+      op == ScanParser::Neq ||
+      op == ScanParser::Gt ||
+      op == ScanParser::Lt ||
+      op == ScanParser::Ge ||
+      op == ScanParser::Le ||
+      op == ScanParser::Within;
+  }
+}
+
+RecordMatcher::RecordMatcher(const string& predicates, size_t stride, size_t minRecords) {
+  if (stride == 0) {
+    throw MedException("Record stride must be positive");
+  }
+  this->stride = stride;
+  this->minRecords = std::max(minRecords, (size_t)1);
+  span = 0;
+
+  for (auto& item : StringUtil::split(predicates, ';')) {
+    string text = StringUtil::trim(item);
+    if (text.length() == 0) {
+      continue;
+    }
+    size_t offsetEnd = text.find(' ');
+    size_t typeEnd = offsetEnd == string::npos ? string::npos : text.find(' ', text.find_first_not_of(' ', offsetEnd));
+    if (typeEnd == string::npos) {
+      throw MedException("Record predicate requires \"offset type condition\": " + text);
+    }
+
+    Predicate predicate;
+    predicate.offset = hexToInt(text.substr(0, offsetEnd));
+    predicate.scanType = stringToScanType(StringUtil::trim(text.substr(offsetEnd, typeEnd - offsetEnd)));
+    if (predicate.scanType == ScanType::String ||
+        predicate.scanType == ScanType::Custom ||
+        predicate.scanType == ScanType::Unknown) {
+      throw MedException("Record predicate only supports numeric type: " + text);
+    }
+
+    string condition = StringUtil::trim(text.substr(typeEnd));
+    predicate.op = ScanParser::getOpType(condition);
+    if (!isRecordOperator(predicate.op)) {
+      throw MedException("Record predicate does not support the operator: " + text);
+    }
+    vector<string> values;
+    for (auto& value : ScanParser::getValues(condition, ' ')) {
+      if (value.length() > 0) {
+        values.push_back(value);
+      }
+    }
+    if (values.size() < 1 || (predicate.op == ScanParser::Within && values.size() < 2)) {
+      throw MedException("Record predicate requires a value: " + text);
+    }
+    try {
+      predicate.low = stod(values[0]);
+      predicate.high = values.size() < 2 ? predicate.low : stod(values[1]);
+    } catch (const std::exception& ex) {
+      throw MedException("Record predicate has an invalid value: " + text);
+    }
+    if (predicate.low > predicate.high) {
+      std::swap(predicate.low, predicate.high);
+    }
+
+    span = std::max(span, predicate.offset + scanTypeToSize(predicate.scanType));
+    this->predicates.push_back(predicate);
+  }
+
+  if (this->predicates.size() == 0) {
+    throw MedException("Record scan requires a predicate");
+  }
+  if (span > stride) {
+    throw MedException("Record predicates exceed the stride");
+  }
+}
+
+size_t RecordMatcher::getStride() {
+  return stride;
+}
+
+size_t RecordMatcher::getMinRecords() {
+  return minRecords;
+}
+
+size_t RecordMatcher::getSpan() {
+  return span;
+}
+
+size_t RecordMatcher::getAlignment() {
+  size_t alignment = 1;
+  while (alignment < 4 && stride % (alignment * 2) == 0) {
+    alignment *= 2;
+  }
+  return alignment;
+}
+
+string RecordMatcher::getScanType() {
+  for (auto& predicate : predicates) {
+    if (predicate.offset == 0) {
+      return scanTypeToString(predicate.scanType);
+    }
+  }
+  return SCAN_TYPE_INT_8;
+}
+
+template<typename T>
+void RecordMatcher::andPredicateOf(const Predicate& predicate, const Byte* block, size_t count, size_t step, Byte* mask) const {
+  const double low = predicate.low;
+  const double high = predicate.high;
+  block += predicate.offset;
+
+  switch (predicate.op) {
+  case ScanParser::OpType::Eq:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v == low; });
+  case ScanParser::OpType::Neq:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v != low; });
+  case ScanParser::OpType::Gt:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v > low; });
+  case ScanParser::OpType::Lt:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v < low; });
+  case ScanParser::OpType::Ge:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v >= low; });
+  case ScanParser::OpType::Le:
+    return BlockMask::andWith<T>(block, count, step, mask, [low](double v) { return v <= low; });
+  case ScanParser::OpType::Within:
+    return BlockMask::andWith<T>(block, count, step, mask, [low, high](double v) { return (v >= low) & (v <= high); });
+  default:
+    memset(mask, 0, count);
+  }
+}
+
+void RecordMatcher::andPredicate(const Predicate& predicate, const Byte* block, size_t count, size_t step, Byte* mask) const {
+  switch (predicate.scanType) {
+  case Int8:
+    return andPredicateOf<int8_t>(predicate, block, count, step, mask);
+  case Int16:
+    return andPredicateOf<int16_t>(predicate, block, count, step, mask);
+  case Int32:
+    return andPredicateOf<int32_t>(predicate, block, count, step, mask);
+  case Ptr32:
+    return andPredicateOf<uint32_t>(predicate, block, count, step, mask);
+  case Int64:
+    return andPredicateOf<int64_t>(predicate, block, count, step, mask);
+  case Ptr64:
+    return andPredicateOf<uint64_t>(predicate, block, count, step, mask);
+  case Float32:
+    return andPredicateOf<float>(predicate, block, count, step, mask);
+  case Float64:
+    return andPredicateOf<double>(predicate, block, count, step, mask);
+  default:
+    memset(mask, 0, count);
+  }
+}
+
+size_t RecordMatcher::matchBlock(const Byte* block, size_t count, size_t step, Byte* mask) const {
+  memset(mask, 1, count);
+  for (auto& predicate : predicates) {
+    andPredicate(predicate, block, count, step, mask);
+  }
+  size_t matched = 0;
+  for (size_t i = 0; i < count; i++) {
+    matched += mask[i];
+  }
+  return matched;
+}
+
+bool RecordMatcher::match(const Byte* record) const {
+  Byte mask;
+  return matchBlock(record, 1, 0, &mask) > 0;
+}
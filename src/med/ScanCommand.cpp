@@ -37,7 +37,7 @@ bool ScanCommand::match(Byte* address) {
   bool result = true;
   Byte *ptr = address;
   for (size_t i = 0; i < subCommands.size(); i++) {
-    SubCommand subCmd = subCommands[i];
+    SubCommand& subCmd = subCommands[i];
     tuple<bool, int> subResult = subCmd.match(ptr);
     bool match = std::get<0>(subResult);
     int step = std::get<1>(subResult);
@@ -49,6 +49,20 @@ bool ScanCommand::match(Byte* address) {
   return result;
 }
 
+size_t ScanCommand::matchBlock(Byte* block, size_t count, size_t step, Byte* mask) {
+  // Single float value is the common case, use the vectorized kernel
+  if (subCommands.size() == 1 && subCommands[0].isFloat()) {
+    return subCommands[0].getFloatMatcher().matchBlock(block, count, step, mask);
+  }
+
+  size_t matched = 0;
+  for (size_t i = 0; i < count; i++) {
+    mask[i] = match(block + i * step);
+    matched += mask[i];
+  }
+  return matched;
+}
+
 string ScanCommand::getFirstScanType() {
   return SubCommand::getScanType(commandString, scanType);
 }
@@ -4,11 +4,13 @@
 #include <sstream>
 #include <iostream>
 #include <cstring>
+#include <iomanip>
 
 #include "med/ScanParser.hpp"
 #include "med/MedException.hpp"
 #include "med/MedCommon.hpp"
 #include "med/SubCommand.hpp"
+#include "med/FloatMatcher.hpp"
 #include "mem/StringUtil.hpp"
 
 using namespace std;
@@ -46,6 +48,18 @@ ScanParser::OpType ScanParser::stringToOpType(const string &s) {
     return ScanParser::Within;
   else if (s == "~")
     return ScanParser::Around;
+  else if (s == "~u")
+    return ScanParser::AroundUlp;
+  else if (s == "~r")
+    return ScanParser::Rounded;
+  else if (s == "~t")
+    return ScanParser::Truncated;
+  else if (s == "+=")
+    return ScanParser::IncreasedBy;
+  else if (s == "-=")
+    return ScanParser::DecreasedBy;
+  else if (s == "%<")
+    return ScanParser::ChangedByPercent;
   return ScanParser::Eq;
 }
 
@@ -82,6 +96,9 @@ bool ScanParser::isValid(const string &v) {
   if (ScanParser::getOpType(v) == ScanParser::Within &&
       !ScanParser::isArray(v, ' '))
     return false;
+  if (ScanParser::isDeltaOperator(ScanParser::getOpType(v)) &&
+      !ScanParser::hasValues(v))
+    return false;
   return true;
 }
 
@@ -141,12 +158,19 @@ bool ScanParser::isSnapshotOperator(const OpType& opType) {
   return false;
 }
 
+bool ScanParser::isDeltaOperator(const OpType& opType) {
+  return opType == IncreasedBy ||
+    opType == DecreasedBy ||
+    opType == ChangedByPercent;
+}
+
 Operands ScanParser::valueToOperands(const string& v, const string& t, OpType op) {
   SizedBytes bytes;
   if (t == SCAN_TYPE_STRING) {
     bytes = stringToBytes(v);
   } else if (op == OpType::Within ||
-             op == OpType::Around) {
+             op == OpType::Around ||
+             op == OpType::AroundUlp) {
     return getTwoOperands(v, t, op);
   } else {
     bytes = numericToBytes(v, t);
@@ -159,7 +183,10 @@ Operands ScanParser::valueToOperands(const string& v, const string& t, OpType op
 
 Operands ScanParser::getTwoOperands(const string& v, const string& t, OpType op) {
   vector<string> values;
-  if (op == OpType::Around) {
+  if (op == OpType::AroundUlp && FloatMatcher::isFloatType(stringToScanType(t))) {
+    return getUlpOperands(v, t);
+  }
+  else if (op == OpType::Around || op == OpType::AroundUlp) {
     values = convertAroundToWithinValues(v);
   }
   else {
@@ -182,6 +209,23 @@ Operands ScanParser::getTwoOperands(const string& v, const string& t, OpType op)
   return Operands(list);
 }
 
+Operands ScanParser::getUlpOperands(const string& v, const string& t) {
+  vector<string> values = getValues(v, ' ');
+  if (values.size() < 1) {
+    throw MedException("Operands should not be less than 1");
+  }
+  int length = scanTypeToSize(t);
+  BytePtr data(new Byte[length]);
+  stringToMemory(values[0], t, data.get());
+
+  int64_t ulps = values.size() < 2 ? 1 : stoll(values[1]);
+  BytePtr ulpsData(new Byte[sizeof(int64_t)]);
+  memcpy(ulpsData.get(), &ulps, sizeof(int64_t));
+
+  vector<SizedBytes> list = { SizedBytes(data, length), SizedBytes(ulpsData, sizeof(int64_t)) };
+  return Operands(list);
+}
+
 ScanCommand ScanParser::getScanCommand(const string& v, const string& scanType) {
   return ScanCommand(v, scanType);
 }
@@ -196,7 +240,11 @@ vector<string> ScanParser::convertAroundToWithinValues(const string& v) {
   else {
     second = stod(values[1]);
   }
-  return vector<string>{to_string(first - second), to_string(first + second)};
+  // to_string() keeps only 6 decimal places, which is too coarse for small tolerance
+  stringstream low, high;
+  low << setprecision(17) << first - second;
+  high << setprecision(17) << first + second;
+  return vector<string>{low.str(), high.str()};
 }
 
 Integers ScanParser::getIntegers(const string &v, char delimiter) {
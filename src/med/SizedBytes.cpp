@@ -31,8 +31,7 @@ BytePtr SizedBytes::getBytePtr() {
 }
 
 Byte* SizedBytes::getBytes() {
-  auto bytePtr = getBytePtr();
-  return bytePtr.get();
+  return std::get<0>(data).get();
 }
 
 bool SizedBytes::isEmpty() {
@@ -4,6 +4,7 @@
 #include "med/SubCommand.hpp"
 #include "med/ScanParser.hpp"
 #include "med/MemOperator.hpp"
+#include "med/MedCommon.hpp"
 #include "mem/StringUtil.hpp"
 
 string extractString(const string& s) {
@@ -33,6 +34,7 @@ int extractNumber(const string &s) {
 SubCommand::SubCommand(const string &s, const string &scanType) {
   cmd = parseCmd(s);
   wildcardSteps = 0;
+  hasFloatMatcher = false;
   string valueStr;
 
   string stripped = stripCommand(s);
@@ -69,6 +71,14 @@ SubCommand::SubCommand(const string &s, const string &scanType) {
     operands = ScanParser::valueToOperands(stripped, fallbackType, op);
     break;
   }
+
+  // An array operand, such as "1.5,2.5", is compared by bytes over its full size
+  ScanType valueType = stringToScanType(getScanType(s, scanType));
+  if (cmd != Command::Wildcard && FloatMatcher::isFloatType(valueType) &&
+      operands.getFirstSize() == (size_t)scanTypeToSize(valueType)) {
+    floatMatcher = FloatMatcher(valueType, operands, op);
+    hasFloatMatcher = true;
+  }
 }
 
 string SubCommand::getScanType(const string &s, const string &scanType) {
@@ -176,7 +186,17 @@ tuple<bool, int> SubCommand::match(Byte* address) {
     matchResult = true;
     break;
   default:
-    matchResult = memCompare(address, size, operands, op);
+    matchResult = hasFloatMatcher ?
+      floatMatcher.match(address) :
+      memCompare(address, size, operands, op);
   }
   return make_tuple(matchResult, size);
 }
+
+bool SubCommand::isFloat() {
+  return hasFloatMatcher;
+}
+
+FloatMatcher& SubCommand::getFloatMatcher() {
+  return floatMatcher;
+}
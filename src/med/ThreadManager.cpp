@@ -19,6 +19,10 @@ void ThreadManager::setMaxThreads(int num) {
   maxThreads = num;
 }
 
+int ThreadManager::getMaxThreads() {
+  return maxThreads;
+}
+
 void ThreadManager::queueTask(TMTask* fn) {
   container.push_back(fn);
 }
@@ -58,8 +62,12 @@ future<void> ThreadManager::startTask(int index) {
       }
       TMTask* fn = container[index];
       (*fn)();
-      numOfRunningThreads--;
 
+      // Decrease under the lock, else the notification can be lost between the predicate check and the wait
+      {
+        lock_guard<mutex> lock(mut);
+        numOfRunningThreads--;
+      }
       cv.notify_one();
     });
   return fut;
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "mem/ChangeProfiler.hpp"
+
+using namespace std;
+
+namespace {
+  const size_t SAMPLE_CHUNK_SIZE = 256 * 1024;
+
+  inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  // Four independent lanes, so that the multiplications are not serialized
+  uint64_t hashBytes(const Byte* data, size_t size) {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t lanes[4] = { 0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL, 0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+      for (int k = 0; k < 4; k++) {
+        uint64_t word;
+        memcpy(&word, data + i + k * 8, 8);
+        lanes[k] = (lanes[k] ^ word) * prime;
+      }
+    }
+    uint64_t h = lanes[0] ^ rotl(lanes[1], 17) ^ rotl(lanes[2], 31) ^ rotl(lanes[3], 47);
+    for (; i < size; i++) {
+      h = (h ^ data[i]) * prime;
+    }
+
+    // Mix the high bits down, so that the truncated line hash still sees them
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+}
+
+ChangeProfiler::ChangeProfiler(MemIO* memio) {
+  this->memio = memio;
+  cursor = 0;
+  interval = DEFAULT_PROFILE_INTERVAL;
+  sliceSize = DEFAULT_PROFILE_SLICE_SIZE;
+  thread = NULL;
+  running = false;
+}
+
+ChangeProfiler::~ChangeProfiler() {
+  stop();
+}
+
+void ChangeProfiler::setRegions(const AddressPairs& regions) {
+  std::lock_guard<std::mutex> sampleLock(sampleMutex);
+  std::lock_guard<std::mutex> lock(mutex);
+  this->regions = regions;
+  sort(this->regions.begin(), this->regions.end());
+  passRegions.clear();
+  cursor = 0;
+}
+
+void ChangeProfiler::setInterval(int ms) {
+  std::lock_guard<std::mutex> lock(mutex);
+  interval = std::max(ms, 1);
+}
+
+int ChangeProfiler::getInterval() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return interval;
+}
+
+void ChangeProfiler::setSliceSize(size_t size) {
+  std::lock_guard<std::mutex> lock(mutex);
+  sliceSize = std::max(size, (size_t)getpagesize());
+}
+
+void ChangeProfiler::start() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    return;
+  }
+  running = true;
+  thread = new std::thread(&ChangeProfiler::run, this);
+}
+
+void ChangeProfiler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      return;
+    }
+    running = false;
+  }
+  cv.notify_all();
+  thread->join();
+  delete thread;
+  thread = NULL;
+}
+
+bool ChangeProfiler::isRunning() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return running;
+}
+
+void ChangeProfiler::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    lock.unlock();
+    sample();
+    lock.lock();
+    cv.wait_for(lock, chrono::milliseconds(interval), [this] { return !running; });
+  }
+}
+
+void ChangeProfiler::clear() {
+  std::lock_guard<std::mutex> sampleLock(sampleMutex);
+  std::lock_guard<std::mutex> lock(mutex);
+  pages.clear();
+  passRegions.clear();
+  cursor = 0;
+}
+
+AddressPairs ChangeProfiler::getSampleRegions() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (regions.size() > 0) {
+      return regions;
+    }
+  }
+  pid_t pid = memio->getPid();
+  if (pid == 0) {
+    return AddressPairs();
+  }
+  try {
+    return getMaps(pid).getMaps();
+  } catch (MedException& e) { // Exited
+    return AddressPairs();
+  }
+}
+
+void ChangeProfiler::sample() {
+  std::lock_guard<std::mutex> sampleLock(sampleMutex);
+  size_t pageSize = getpagesize();
+  size_t budget;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    budget = sliceSize;
+  }
+
+  if (passRegions.empty()) {
+    passRegions = getSampleRegions();
+    cursor = 0;
+  }
+
+  vector<Byte> buffer(SAMPLE_CHUNK_SIZE);
+  size_t i = 0;
+  while (budget > 0 && i < passRegions.size()) {
+    Address start = std::max(cursor, passRegions[i].first) / pageSize * pageSize;
+    Address end = passRegions[i].second;
+    if (start >= end || cursor >= end) {
+      i++;
+      continue;
+    }
+
+    size_t size = std::min({ (size_t)(end - start), SAMPLE_CHUNK_SIZE, budget });
+    size = std::max(size / pageSize, (size_t)1) * pageSize;
+
+    // Read the chunk at once, or page by page if part of it is not readable
+    bool whole = memio->read(start, buffer.data(), size) == (ssize_t)size;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (size_t offset = 0; offset < size; offset += pageSize) {
+        if (whole || memio->read(start + offset, buffer.data() + offset, pageSize) == (ssize_t)pageSize) {
+          samplePage(start + offset, buffer.data() + offset, pageSize);
+        }
+      }
+    }
+
+    cursor = start + size;
+    budget -= std::min(budget, size);
+  }
+
+  while (i < passRegions.size() && cursor >= passRegions[i].second) {
+    i++;
+  }
+  if (i >= passRegions.size()) { // Pass completed, the maps are read again on the next sample
+    passRegions.clear();
+    cursor = 0;
+  }
+}
+
+void ChangeProfiler::samplePage(Address address, const Byte* page, size_t pageSize) {
+  uint64_t hash = hashBytes(page, pageSize);
+  auto it = pages.find(address);
+  if (it == pages.end()) {
+    pages[address] = PageState { hash, 1, 0, vector<uint32_t>(), vector<uint32_t>() };
+    return;
+  }
+
+  PageState& state = it->second;
+  state.samples++;
+  if (state.hash == hash) {
+    return;
+  }
+  state.hash = hash;
+  state.changes++;
+
+  size_t lines = pageSize / CACHE_LINE_SIZE;
+  if (state.lineHashes.empty()) {
+    state.lineHashes.resize(lines);
+    state.lineChanges.assign(lines, 0);
+    for (size_t i = 0; i < lines; i++) {
+      state.lineHashes[i] = (uint32_t)hashBytes(page + i * CACHE_LINE_SIZE, CACHE_LINE_SIZE);
+    }
+    return;
+  }
+  for (size_t i = 0; i < lines; i++) {
+    uint32_t lineHash = (uint32_t)hashBytes(page + i * CACHE_LINE_SIZE, CACHE_LINE_SIZE);
+    if (lineHash != state.lineHashes[i]) {
+      state.lineHashes[i] = lineHash;
+      state.lineChanges[i]++;
+    }
+  }
+}
+
+vector<PageHeat> ChangeProfiler::getHeatMap() {
+  std::lock_guard<std::mutex> lock(mutex);
+  vector<PageHeat> heatMap;
+  heatMap.reserve(pages.size());
+  for (auto& pair : pages) {
+    auto& state = pair.second;
+    double rate = state.samples > 1 ? (double)state.changes / (state.samples - 1) : 0;
+    heatMap.push_back(PageHeat { pair.first, state.samples, state.changes, rate, state.lineChanges });
+  }
+  return heatMap;
+}
+
+AddressPairs ChangeProfiler::getVolatileRanges(double minRate) {
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t pageSize = getpagesize();
+  AddressPairs ranges;
+  for (auto& pair : pages) {
+    auto& state = pair.second;
+    if (state.samples < 2 || (double)state.changes / (state.samples - 1) < minRate) {
+      continue;
+    }
+    if (ranges.size() > 0 && ranges.back().second == pair.first) {
+      ranges.back().second += pageSize;
+    }
+    else {
+      ranges.push_back(AddressPair(pair.first, pair.first + pageSize));
+    }
+  }
+  return ranges;
+}
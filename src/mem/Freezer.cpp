@@ -0,0 +1,169 @@
+#include <cstring>
+
+#include "mem/Freezer.hpp"
+#include "mem/ReadPlanner.hpp"
+
+using namespace std;
+
+Freezer::Freezer(MemIO* memio) {
+  this->memio = memio;
+  nextGeneration = 0;
+  thread = NULL;
+  running = false;
+  writeOnlyIfChanged = false;
+}
+
+Freezer::~Freezer() {
+  stop();
+}
+
+void Freezer::start() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    return;
+  }
+  running = true;
+  thread = new std::thread(&Freezer::run, this);
+}
+
+void Freezer::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      return;
+    }
+    running = false;
+  }
+  cv.notify_all();
+  thread->join();
+  delete thread;
+  thread = NULL;
+}
+
+void Freezer::add(SemPtr sem) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t generation = ++nextGeneration;
+    generations[sem.get()] = generation;
+    queue.push(Entry { Clock::now(), sem, sem.get(), generation });
+  }
+  cv.notify_all();
+}
+
+void Freezer::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  queue = priority_queue<Entry, vector<Entry>, greater<Entry>>();
+  generations.clear();
+}
+
+size_t Freezer::size() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return generations.size();
+}
+
+void Freezer::setWriteOnlyIfChanged(bool value) {
+  writeOnlyIfChanged = value;
+}
+
+bool Freezer::getWriteOnlyIfChanged() {
+  return writeOnlyIfChanged;
+}
+
+void Freezer::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    if (queue.empty()) {
+      cv.wait(lock, [this] { return !running || !queue.empty(); });
+      continue;
+    }
+
+    Clock::time_point now = Clock::now();
+    Clock::time_point due = queue.top().due;
+    if (due > now) {
+      cv.wait_until(lock, due);
+      continue;
+    }
+
+    vector<SemPtr> sems;
+    while (!queue.empty() && queue.top().due <= now) {
+      Entry entry = queue.top();
+      queue.pop();
+
+      auto it = generations.find(entry.key);
+      if (it == generations.end() || it->second != entry.generation) { // Rescheduled, this entry is outdated
+        continue;
+      }
+      SemPtr sem = entry.sem.lock();
+      if (!sem || !sem->isLocked()) {
+        generations.erase(it);
+        continue;
+      }
+
+      sems.push_back(sem);
+
+      // Skip the missed ticks instead of writing them in a burst
+      entry.due += chrono::milliseconds(sem->getLockInterval());
+      if (entry.due <= now) {
+        entry.due = now + chrono::milliseconds(sem->getLockInterval());
+      }
+      queue.push(entry);
+    }
+
+    lock.unlock();
+    writeNow(sems);
+    lock.lock();
+  }
+}
+
+void Freezer::writeNow(const vector<SemPtr>& sems) {
+  // Each process is written in its own batch
+  map<MemIO*, vector<SemPtr>> groups;
+  for (auto& sem : sems) {
+    groups[sem->getMemIO() ? sem->getMemIO() : memio].push_back(sem);
+  }
+  for (auto& group : groups) {
+    write(group.first, group.second);
+  }
+}
+
+void Freezer::write(MemIO* memio, vector<SemPtr>& sems) {
+  // Keep the bytes until written, the ranges only point to them
+  vector<SizedBytes> values;
+  vector<MemRange> ranges;
+  vector<size_t> indices; // Sem of the range
+  for (size_t i = 0; i < sems.size(); i++) {
+    auto& sem = sems[i];
+    SizedBytes bytes = sem->getLockedBytes();
+    if (bytes.isEmpty()) {
+      continue;
+    }
+    values.push_back(bytes);
+    indices.push_back(i);
+    ranges.push_back(MemRange { sem->getAddress(), bytes.getSize(), bytes.getBytes(), false });
+  }
+  if (writeOnlyIfChanged && ranges.size()) {
+    ReadPlanner planner;
+    for (auto& range : ranges) {
+      planner.add(range.address, range.size);
+    }
+    planner.read(memio);
+
+    // Keep only the changed values, and the unreadable values which may still be writable
+    size_t numOfChanged = 0;
+    for (size_t i = 0; i < ranges.size(); i++) {
+      Byte* current = planner.getData(i);
+      if (current && memcmp(current, ranges[i].buffer, ranges[i].size) == 0) {
+        continue;
+      }
+      if (current) {
+        sems[indices[i]]->addCorrection();
+      }
+      ranges[numOfChanged++] = ranges[i];
+    }
+    ranges.resize(numOfChanged);
+  }
+
+  if (ranges.size()) {
+    memio->write(ranges);
+  }
+}
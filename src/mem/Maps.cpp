@@ -33,6 +33,29 @@ size_t Maps::size() {
   return maps.size();
 }
 
+void Maps::sort() {
+  std::sort(maps.begin(), maps.end());
+}
+
+bool Maps::contains(Address address) {
+  auto it = upper_bound(maps.begin(), maps.end(), address, [](Address value, const AddressPair& pair) {
+      return value < pair.first;
+    });
+  if (it == maps.begin()) {
+    return false;
+  }
+  --it;
+  return address >= it->first && address < it->second;
+}
+
+size_t Maps::getTotalSize() {
+  size_t total = 0;
+  for (auto& pair : maps) {
+    total += pair.second - pair.first;
+  }
+  return total;
+}
+
 void Maps::clear() {
   maps.clear();
 }
@@ -71,3 +94,22 @@ void Maps::trimByScope(const AddressPair& scope) {
 
   maps = newMaps;
 }
+
+void Maps::exclude(const AddressPairs& ranges) {
+  for (auto& range : ranges) {
+    AddressPairs newMaps;
+    for (auto& pair : maps) {
+      if (range.second <= pair.first || range.first >= pair.second) {
+        newMaps.push_back(pair);
+        continue;
+      }
+      if (range.first > pair.first) {
+        newMaps.push_back(AddressPair(pair.first, range.first));
+      }
+      if (range.second < pair.second) {
+        newMaps.push_back(AddressPair(range.second, pair.second));
+      }
+    }
+    maps = newMaps;
+  }
+}
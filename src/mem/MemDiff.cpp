@@ -0,0 +1,147 @@
+#include <cstring>
+
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "mem/MemDiff.hpp"
+#include "mem/Pem.hpp"
+
+using namespace std;
+
+namespace {
+  const size_t BLOCK_SIZE = 64;
+
+  void addChange(vector<DiffRange>& ranges, Address address, size_t gap) {
+    if (ranges.size() > 0) {
+      DiffRange& last = ranges.back();
+      Address end = last.address + last.size;
+      if (address < end + gap + 1) {
+        last.size = address + 1 - last.address;
+        return;
+      }
+    }
+    ranges.push_back(DiffRange { address, 1 });
+  }
+}
+
+bool MemSnapshot::isReadable(size_t offset) const {
+  size_t page = offset / MemDiff::PAGE_SIZE;
+  return page < readable.size() && readable[page];
+}
+
+MemDiff::MemDiff(MemIO* memio) {
+  this->memio = memio;
+}
+
+MemSnapshot MemDiff::take(Address address, size_t size) {
+  MemSnapshot snapshot;
+  snapshot.address = address;
+  snapshot.data.assign(size, 0);
+
+  // Read by page, so that an unreadable page doesn't fail the region
+  vector<MemRange> ranges;
+  for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+    ranges.push_back(MemRange { address + offset, std::min(PAGE_SIZE, size - offset), snapshot.data.data() + offset, false });
+  }
+  memio->read(ranges);
+
+  snapshot.readable.resize(ranges.size());
+  for (size_t i = 0; i < ranges.size(); i++) {
+    snapshot.readable[i] = ranges[i].valid;
+    if (!ranges[i].valid) {
+      memset(ranges[i].buffer, 0, ranges[i].size);
+    }
+  }
+  return snapshot;
+}
+
+vector<DiffRange> MemDiff::compare(const MemSnapshot& before, const MemSnapshot& after, size_t gap) {
+  if (before.address != after.address || before.data.size() != after.data.size()) {
+    throw MedException("Snapshots are not of the same region");
+  }
+
+  vector<DiffRange> ranges;
+  size_t size = before.data.size();
+  for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+    if (!before.isReadable(offset) || !after.isReadable(offset)) {
+      continue;
+    }
+    size_t length = std::min(PAGE_SIZE, size - offset);
+    auto changes = diff(before.address + offset, before.data.data() + offset, after.data.data() + offset, length, gap);
+    for (auto& change : changes) {
+      // Coalesce across the page boundary
+      if (ranges.size() > 0 && change.address < ranges.back().address + ranges.back().size + gap + 1) {
+        ranges.back().size = change.address + change.size - ranges.back().address;
+      }
+      else {
+        ranges.push_back(change);
+      }
+    }
+  }
+  return ranges;
+}
+
+vector<DiffRange> MemDiff::compareLive(const MemSnapshot& before, MemSnapshot& after, size_t gap) {
+  after = take(before.address, before.data.size());
+  return compare(before, after, gap);
+}
+
+vector<DiffRange> MemDiff::diff(Address base, const Byte* before, const Byte* after, size_t size, size_t gap) {
+  vector<DiffRange> ranges;
+  size_t i = 0;
+  while (i < size) {
+    size_t length = std::min(BLOCK_SIZE, size - i);
+    if (memcmp(before + i, after + i, length) == 0) {
+      i += length;
+      continue;
+    }
+
+    size_t end = i + length;
+    for (; i + sizeof(uint64_t) <= end; i += sizeof(uint64_t)) {
+      uint64_t a, b;
+      memcpy(&a, before + i, sizeof(a));
+      memcpy(&b, after + i, sizeof(b));
+      uint64_t changed = a ^ b;
+      while (changed) {
+        size_t byte = __builtin_ctzll(changed) / 8; // Little endian
+        addChange(ranges, base + i + byte, gap);
+        changed &= ~((uint64_t)0xff << (byte * 8));
+      }
+    }
+    for (; i < end; i++) {
+      if (before[i] != after[i]) {
+        addChange(ranges, base + i, gap);
+      }
+    }
+  }
+  return ranges;
+}
+
+vector<DiffValue> MemDiff::interpret(const MemSnapshot& before,
+                                     const MemSnapshot& after,
+                                     const DiffRange& range,
+                                     const string& scanType) {
+  vector<DiffValue> values;
+  size_t size = scanType == SCAN_TYPE_STRING ? range.size : scanTypeToSize(scanType);
+  if (size == 0) {
+    return values;
+  }
+
+  Address start = range.address;
+  Address end = range.address + range.size;
+  if (scanType != SCAN_TYPE_STRING) {
+    start -= start % size;
+  }
+  for (Address address = start; address < end; address += size) {
+    if (address < before.address || address + size > before.address + before.data.size()) {
+      continue; // Field is cut by the region
+    }
+    size_t offset = address - before.address;
+    DiffValue value { address, "", "" };
+    try {
+      value.before = Pem::bytesToString((Byte*)before.data.data() + offset, size, scanType);
+      value.after = Pem::bytesToString((Byte*)after.data.data() + offset, size, scanType);
+    } catch (const MedException& ex) {}
+    values.push_back(value);
+  }
+  return values;
+}
@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <cerrno>
 #include <iostream>
 #include <fstream>
 
+#include <signal.h>
+
 #include "mem/MemEd.hpp"
 #include "med/MedCommon.hpp"
 #include "med/MedException.hpp"
 #include "med/ScanCommand.hpp"
+#include "med/SubCommand.hpp"
+#include "med/DeltaMatcher.hpp"
 #include "mem/Sem.hpp"
 
 using namespace std;
@@ -19,12 +25,22 @@ MemEd::MemEd(pid_t pid) {
 }
 
 MemEd::~MemEd() {
+  processWatcher.stop();
+  cancelScan();
+  waitAsync();
+
+  freezer->stop();
+  delete freezer;
+
+  changeProfiler->stop();
+  delete changeProfiler;
+
   delete scanner;
+  for (auto sessionScanner : sessionScanners) {
+    delete sessionScanner;
+  }
 
   delete store;
-
-  lockValueThread->join();
-  delete lockValueThread;
 }
 
 void MemEd::initialize() {
@@ -36,18 +52,148 @@ void MemEd::initialize() {
   canResumeProcess = true;
   isProcessPaused = false;
 
-  lockValueThread = new std::thread(MemEd::callLockValues, this);
+  freezer = new Freezer(scanner->getMemIO());
+  freezer->start();
+
+  changeProfiler = new ChangeProfiler(scanner->getMemIO());
+  skipVolatile = false;
+
+  scanThread = NULL;
+  scanning = false;
 }
 
 void MemEd::setPid(pid_t pid) {
   this->pid = pid;
   scanner->setPid(pid);
+  activeScanners.clear();
+  changeProfiler->clear();
 }
 
 pid_t MemEd::getPid() {
   return pid;
 }
 
+void MemEd::setSessionPids(const vector<pid_t>& pids) {
+  waitAsync();
+  activeScanners.clear();
+  for (auto sessionPid : pids) {
+    auto current = getSessionPids();
+    if (sessionPid <= 0 || std::find(current.begin(), current.end(), sessionPid) != current.end()) {
+      continue;
+    }
+    auto it = std::find_if(sessionScanners.begin(), sessionScanners.end(),
+                           [sessionPid](MemScanner* s) { return s->getPid() == sessionPid; });
+    MemScanner* sessionScanner;
+    if (it != sessionScanners.end()) { // Rejoined
+      sessionScanner = *it;
+    } else {
+      sessionScanner = new MemScanner(sessionPid);
+      sessionScanners.push_back(sessionScanner);
+    }
+    activeScanners.push_back(sessionScanner);
+    sessionScanner->setScopeStart(scanner->getScope()->first);
+    sessionScanner->setScopeEnd(scanner->getScope()->second);
+  }
+}
+
+void MemEd::addProcessTree() {
+  if (!pid) {
+    return;
+  }
+  vector<pid_t> pids = getSessionPids();
+  processEnumerator.refresh();
+  for (auto child : processEnumerator.getTree(pid)) {
+    pids.push_back(child);
+  }
+  setSessionPids(pids);
+}
+
+vector<pid_t> MemEd::getSessionPids() {
+  vector<pid_t> pids;
+  for (auto sessionScanner : getScanners()) {
+    pids.push_back(sessionScanner->getPid());
+  }
+  return pids;
+}
+
+MemIO* MemEd::getMemIO(pid_t pid) {
+  for (auto sessionScanner : getScanners()) {
+    if (sessionScanner->getPid() == pid) {
+      return sessionScanner->getMemIO();
+    }
+  }
+  return NULL;
+}
+
+vector<MemScanner*> MemEd::getScanners() {
+  vector<MemScanner*> scanners = { scanner };
+  scanners.insert(scanners.end(), activeScanners.begin(), activeScanners.end());
+  return scanners;
+}
+
+/**
+ * Split the list by the process of each value, the values of an unknown MemIO go to the selected process
+ */
+map<MemScanner*, vector<MemPtr>> MemEd::partition(const vector<MemPtr>& list) {
+  map<MemScanner*, vector<MemPtr>> parts;
+  map<MemIO*, MemScanner*> scanners;
+  for (auto sessionScanner : getScanners()) {
+    parts[sessionScanner] = vector<MemPtr>();
+    scanners[sessionScanner->getMemIO()] = sessionScanner;
+  }
+  for (auto& mem : list) {
+    auto it = scanners.find(static_pointer_cast<Pem>(mem)->getMemIO());
+    parts[it == scanners.end() ? scanner : it->second].push_back(mem);
+  }
+  return parts;
+}
+
+vector<MemPtr> MemEd::forEachScanner(std::function<vector<MemPtr>(MemScanner*)> fn) {
+  vector<MemScanner*> scanners = getScanners();
+  if (scanners.size() == 1) {
+    return fn(scanner);
+  }
+
+  ScanProgressPtr progress = scanner->getProgress();
+  progress->begin(0, 0);
+  progress->setShared(true);
+  int share = MemScanner::DEFAULT_MAX_THREADS / scanners.size();
+
+  vector<vector<MemPtr>> results(scanners.size());
+  vector<string> errors(scanners.size());
+  vector<std::thread> threads;
+  for (size_t i = 0; i < scanners.size(); i++) {
+    scanners[i]->setMaxThreads(share);
+    scanners[i]->setProgress(progress);
+    threads.push_back(std::thread([&fn, &scanners, &results, &errors, i]() {
+        try {
+          results[i] = fn(scanners[i]);
+        } catch (MedException& e) {
+          errors[i] = e.getMessage();
+        }
+      }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  progress->setShared(false);
+
+  vector<MemPtr> mems;
+  size_t failed = 0;
+  for (size_t i = 0; i < scanners.size(); i++) {
+    scanners[i]->setMaxThreads(MemScanner::DEFAULT_MAX_THREADS);
+    if (errors[i].length() > 0) {
+      failed++;
+      continue;
+    }
+    mems.insert(mems.end(), results[i].begin(), results[i].end());
+  }
+  if (failed == scanners.size()) {
+    throw MedException(errors[0]);
+  }
+  return mems;
+}
+
 vector<MemPtr> MemEd::scan(const string& value, const string& scanType, bool fastScan, const string& lastDigit) {
   if (!ScanParser::isValid(value)) {
     throw MedException("Invalid scan string");
@@ -58,10 +204,19 @@ vector<MemPtr> MemEd::scan(const string& value, const string& scanType, bool fas
 
   vector<MemPtr> mems;
   if (op == ScanParser::OpType::SnapshotSave) {
-    scanner->saveSnapshot(store->getList());
+    auto parts = partition(store->getList());
+    forEachScanner([&parts](MemScanner* s) {
+        s->saveSnapshot(parts.at(s));
+        return vector<MemPtr>();
+      });
   } else {
     ScanCommand scanCommand = ScanParser::getScanCommand(value, scanType);
-    mems = scanner->scan(scanCommand, lastDigitValues, fastScan);
+    AddressPairs excluded = skipVolatile ? changeProfiler->getVolatileRanges() : AddressPairs();
+    mems = forEachScanner([this, &scanCommand, &excluded, &lastDigitValues, fastScan](MemScanner* s) {
+        ScanCommand command = scanCommand;
+        s->setExcludedRanges(s == scanner ? excluded : AddressPairs()); // Profiled by the selected process
+        return s->scan(command, lastDigitValues, fastScan);
+      });
   }
   namedScans.setMemPtrs(mems, scanType);
   return mems;
@@ -74,17 +229,103 @@ vector<MemPtr> MemEd::filter(const string& value, const string& scanType, bool f
 
   vector<MemPtr> mems;
   ScanParser::OpType op = ScanParser::getOpType(value);
-  if (ScanParser::isSnapshotOperator(op) && !ScanParser::hasValues(value)) {
-    mems = scanner->filterUnknown(namedScans.getMemList()->getList(), scanType, op, fastScan);
+  auto parts = partition(namedScans.getMemList()->getList());
+  if (ScanParser::isDeltaOperator(op)) {
+    DeltaMatcher matcher(value, SubCommand::getScanType(value, scanType));
+    mems = forEachScanner([&parts, &matcher, fastScan](MemScanner* s) {
+        return s->filterDelta(parts.at(s), matcher, fastScan);
+      });
+  } else if (ScanParser::isSnapshotOperator(op) && !ScanParser::hasValues(value)) {
+    mems = forEachScanner([&parts, &scanType, op, fastScan](MemScanner* s) {
+        return s->filterUnknown(parts.at(s), scanType, op, fastScan);
+      });
   } else {
     ScanCommand scanCommand = ScanParser::getScanCommand(value, scanType);
-    mems = scanner->filter(namedScans.getMemList()->getList(), scanCommand);
+    mems = forEachScanner([&parts, &scanCommand](MemScanner* s) {
+        ScanCommand command = scanCommand;
+        return s->filter(parts.at(s), command);
+      });
   }
 
+  // A cancelled filter keeps the previous list, whose candidates are not all checked
+  if (scanner->getProgress()->isCancelled()) {
+    return namedScans.getMemList()->getList();
+  }
   namedScans.setMemPtrs(mems, scanType);
   return mems;
 }
 
+vector<MemPtr> MemEd::scanRecords(const string& predicates, size_t stride, size_t minRecords) {
+  RecordMatcher matcher(predicates, stride, minRecords);
+  AddressPairs excluded = skipVolatile ? changeProfiler->getVolatileRanges() : AddressPairs();
+  vector<MemPtr> mems = forEachScanner([this, &matcher, &excluded](MemScanner* s) {
+      s->setExcludedRanges(s == scanner ? excluded : AddressPairs());
+      return s->scanRecords(matcher);
+    });
+  namedScans.setMemPtrs(mems, matcher.getScanType());
+  return mems;
+}
+
+ScanProgressPtr MemEd::scanAsync(const string& value, const string& scanType, bool fastScan, const string& lastDigit) {
+  return startAsync([this, value, scanType, fastScan, lastDigit]() {
+      return scan(value, scanType, fastScan, lastDigit);
+    });
+}
+
+ScanProgressPtr MemEd::filterAsync(const string& value, const string& scanType, bool fastScan) {
+  return startAsync([this, value, scanType, fastScan]() {
+      return filter(value, scanType, fastScan);
+    });
+}
+
+ScanProgressPtr MemEd::scanRecordsAsync(const string& predicates, size_t stride, size_t minRecords) {
+  return startAsync([this, predicates, stride, minRecords]() {
+      return scanRecords(predicates, stride, minRecords);
+    });
+}
+
+ScanProgressPtr MemEd::startAsync(std::function<vector<MemPtr>()> fn) {
+  waitAsync();
+  ScanProgressPtr progress = ScanProgressPtr(new ScanProgress());
+  scanProgress = progress;
+  scanner->setProgress(progress);
+  scanning = true;
+
+  scanThread = new std::thread([this, fn, progress]() {
+      vector<MemPtr> results;
+      string error;
+      try {
+        results = fn();
+      } catch (MedException& e) {
+        error = e.getMessage();
+      }
+      // The following synchronous scans are not affected by the cancel
+      scanner->setProgress(ScanProgressPtr(new ScanProgress()));
+      scanning = false;
+      progress->finish(results, error);
+    });
+  return progress;
+}
+
+void MemEd::waitAsync() {
+  if (!scanThread) {
+    return;
+  }
+  scanThread->join();
+  delete scanThread;
+  scanThread = NULL;
+}
+
+bool MemEd::isScanning() {
+  return scanning;
+}
+
+void MemEd::cancelScan() {
+  if (scanProgress) {
+    scanProgress->cancel();
+  }
+}
+
 NamedScans& MemEd::getNamedScans() {
   return namedScans;
 }
@@ -94,17 +335,109 @@ MemList MemEd::getScans() {
   return list;
 }
 
-vector<Process> MemEd::listProcesses() {
-  processes = pidList();
+vector<Process> MemEd::listProcesses(const string& name, size_t minRss) {
+  refreshProcesses();
+  return filterProcesses(name, minRss);
+}
+
+void MemEd::refreshProcesses() {
+  processEnumerator.refresh();
+}
+
+vector<Process> MemEd::filterProcesses(const string& name, size_t minRss) {
+  processes = processEnumerator.filter(name, minRss);
   return processes;
 }
 
 Process MemEd::selectProcessByIndex(int index) {
   selectedProcess = processes[index];
   setPid(stoi(selectedProcess.pid));
+  processWatcher.watch(selectedProcess);
   return selectedProcess;
 }
 
+Process MemEd::selectProcess(const string& pid) {
+  for (size_t i = 0; i < processes.size(); i++) {
+    if (processes[i].pid == pid) {
+      return selectProcessByIndex(i);
+    }
+  }
+  throw MedException("Process not found: " + pid);
+}
+
+Process MemEd::selectLargestProcess(const string& name) {
+  processEnumerator.refresh();
+  vector<Process> largest = processEnumerator.getLargest(1, name);
+  if (largest.size() == 0) {
+    return Process();
+  }
+  processes = largest;
+  return selectProcessByIndex(0);
+}
+
+bool MemEd::reattachIfRestarted(size_t* numOfUnlocked) {
+  Process process;
+  vector<Module> oldModules;
+  if (!processWatcher.takeRestart(process, oldModules)) {
+    return false;
+  }
+  cancelScan();
+  waitAsync();
+
+  vector<Module> newModules;
+  try {
+    newModules = getModules(stoi(process.pid));
+  } catch (MedException& e) { // Exited again, the next instance will be taken
+    return false;
+  }
+
+  // Unlock before the MemIO is moved to the new instance, so that the freezer never writes to the old addresses
+  vector<SemPtr> relocatedLocks;
+  size_t unlocked = 0;
+  storeMutex.lock();
+  for (auto& mem : store->getList()) {
+    auto sem = static_pointer_cast<Sem>(mem);
+    if (sem->getMemIO() != scanner->getMemIO()) { // Of another session process
+      continue;
+    }
+    bool relocated;
+    sem->setAddress(relocateAddress(sem->getAddress(), oldModules, newModules, &relocated));
+    if (!sem->isLocked()) {
+      continue;
+    }
+    if (relocated) {
+      relocatedLocks.push_back(sem);
+    } else {
+      sem->lock(false);
+      unlocked++;
+    }
+  }
+  storeMutex.unlock();
+
+  // Keep the other processes of the session, which are still running
+  vector<pid_t> others;
+  for (auto sessionPid : getSessionPids()) {
+    if (sessionPid != pid && (kill(sessionPid, 0) == 0 || errno == EPERM)) {
+      others.push_back(sessionPid);
+    }
+  }
+
+  selectedProcess = process;
+  setPid(stoi(process.pid));
+  setSessionPids(others);
+  for (auto& sem : relocatedLocks) {
+    freezer->add(sem);
+  }
+  if (numOfUnlocked) {
+    *numOfUnlocked = unlocked;
+  }
+  return true;
+}
+
+bool MemEd::isProcessExited() {
+  return processWatcher.isExited();
+}
+
 void MemEd::clearScans() {
   namedScans.getMemList()->clear();
 }
@@ -120,28 +453,47 @@ void MemEd::addToStoreByIndex(int index) {
   getStore()->addMemPtr(sem);
 }
 
-void MemEd::callLockValues(MemEd* med) {
-  while (1) {
-    if (med->hasLockValue()) {
-      med->lockValues();
-      if (!med->getIsProcessPaused() && med->getCanResumeProcess()) {
-        med->resumeProcess();
-      }
-    }
-    std::this_thread::sleep_for(chrono::milliseconds(LOCK_REFRESH_RATE));
-  }
-}
-
 void MemEd::lockValues() {
+  vector<SemPtr> sems;
   storeMutex.lock();
-  auto list = getStore()->getList();
-  for (size_t i = 0; i < list.size(); i++) {
-    auto sem = static_pointer_cast<Sem>(list[i]);
+  for (auto& mem : getStore()->getList()) {
+    auto sem = static_pointer_cast<Sem>(mem);
     if (sem->isLocked()) {
-      sem->lockValue();
+      sems.push_back(sem);
     }
   }
   storeMutex.unlock();
+  freezer->writeNow(sems);
+}
+
+void MemEd::setLocked(SemPtr sem, bool value) {
+  sem->lock(value);
+  if (value) {
+    freezer->add(sem);
+  }
+}
+
+void MemEd::setLockInterval(SemPtr sem, int ms) {
+  sem->setLockInterval(ms);
+  if (sem->isLocked()) {
+    freezer->add(sem); // Reschedule by the new interval
+  }
+}
+
+void MemEd::setWriteOnlyIfChanged(bool value) {
+  freezer->setWriteOnlyIfChanged(value);
+}
+
+ScanStats MemEd::getScanStats() {
+  return scanner->getStats();
+}
+
+ChangeProfiler* MemEd::getChangeProfiler() {
+  return changeProfiler;
+}
+
+void MemEd::setSkipVolatile(bool value) {
+  skipVolatile = value;
 }
 
 bool MemEd::hasLockValue() {
@@ -174,6 +526,8 @@ void MemEd::saveFile(const char* filename) {
       pairs["value"] = "";
     }
     pairs["lock"] = sem->isLocked();
+    pairs["lockInterval"] = sem->getLockInterval();
+    pairs["pid"] = sem->getMemIO()->getPid();
     root["addresses"].append(pairs);
   }
   root["notes"] = getNotes();
@@ -210,10 +564,14 @@ void MemEd::loadJson(Json::Value& root) {
     string scanType = addresses[i]["type"].asString();
     int size = scanTypeToSize(scanType);
 
-    SemPtr sem = SemPtr(new Sem(size, memio));
+    MemIO* entryMemIO = addresses[i].isMember("pid") ? getMemIO(addresses[i]["pid"].asInt()) : NULL;
+    SemPtr sem = SemPtr(new Sem(size, entryMemIO ? entryMemIO : memio));
     sem->setAddress(hexToInt(addresses[i]["address"].asString()));
     sem->setScanType(scanType);
     sem->setDescription(addresses[i]["description"].asString());
+    if (addresses[i].isMember("lockInterval")) {
+      sem->setLockInterval(addresses[i]["lockInterval"].asInt());
+    }
     sem->lock(false); // always open as false, so that do not update the value
 
     getStore()->getList().push_back(sem);
@@ -264,6 +622,10 @@ MemPtr MemEd::readMemory(Address addr, size_t size) {
   return memio->read(addr, size);
 }
 
+MemIO* MemEd::getMemIO() {
+  return scanner->getMemIO();
+}
+
 void MemEd::setValueByAddress(Address addr, const string& value, const string& scanType) {
   auto memio = scanner->getMemIO();
   size_t size = scanTypeToSize(scanType);
@@ -272,11 +634,15 @@ void MemEd::setValueByAddress(Address addr, const string& value, const string& s
 }
 
 void MemEd::setScopeStart(Address addr) {
-  scanner->setScopeStart(addr);
+  for (auto sessionScanner : getScanners()) {
+    sessionScanner->setScopeStart(addr);
+  }
 }
 
 void MemEd::setScopeEnd(Address addr) {
-  scanner->setScopeEnd(addr);
+  for (auto sessionScanner : getScanners()) {
+    sessionScanner->setScopeEnd(addr);
+  }
 }
 
 std::mutex& MemEd::getScanListMutex() {
@@ -285,8 +651,12 @@ std::mutex& MemEd::getScanListMutex() {
 
 void MemEd::resumeProcess() {
   isProcessPaused = false;
-  if (pid && isPidSuspended(pid)) {
-    pidResume(pid);
+  if (!pid) return;
+
+  for (auto sessionPid : getSessionPids()) {
+    if (isPidSuspended(sessionPid)) {
+      pidResume(sessionPid);
+    }
   }
 }
 
@@ -294,7 +664,9 @@ void MemEd::pauseProcess() {
   if (!pid) return;
 
   isProcessPaused = true;
-  pidStop(pid);
+  for (auto sessionPid : getSessionPids()) {
+    pidStop(sessionPid);
+  }
 }
 
 void MemEd::setCanResumeProcess(bool value) {
@@ -1,7 +1,11 @@
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <sys/ptrace.h> //ptrace()
 #include <sys/prctl.h> //prctl()
+#include <sys/uio.h> //process_vm_readv(), process_vm_writev()
+#include <fcntl.h> //open
+#include <climits> //IOV_MAX
 #include <unistd.h> //open, read, lseek
 #include <iostream>
 
@@ -12,11 +16,27 @@
 
 using namespace std;
 
+// Larger range is read by its own pread, instead of an iovec
+const size_t LARGE_RANGE_SIZE = 64 * 1024;
+
+namespace {
+  thread_local MemIOStats threadStats = { 0, 0, 0 };
+}
+
 MemIO::MemIO() {
   pid = 0;
+  canReadVector = true;
+  canWriteVector = true;
+  resetStats();
 }
 
+MemIO::~MemIO() {}
+
 void MemIO::setPid(pid_t pid) {
+  // Together, so that no thread reopens the mem of the previous pid in between.
+  // The fd is closed once the reads and writes in progress release it.
+  std::lock_guard<std::mutex> lock(memFdMutex);
+  memFd.reset();
   this->pid = pid;
 }
 
@@ -31,6 +51,214 @@ MemPtr MemIO::read(Address addr, size_t size) {
   return readDirect(addr, size);
 }
 
+ssize_t MemIO::read(Address addr, Byte* buffer, size_t size) {
+  if (!pid) {
+    memcpy(buffer, (void*)addr, size);
+    return size;
+  }
+
+  MemFdPtr fd = getMemFd();
+  if (!fd) {
+    return -1;
+  }
+  ssize_t ret = pread(*fd, buffer, size, (off_t)addr);
+  countRead(size, ret > 0 ? ret : 0, 1);
+  return ret;
+}
+
+size_t MemIO::read(vector<MemRange>& ranges, size_t bytesNeeded) {
+  size_t total = 0;
+  for (auto& range : ranges) {
+    total += range.size;
+  }
+  countRead(bytesNeeded ? bytesNeeded : total, 0, 0);
+
+  if (!pid) {
+    for (auto& range : ranges) {
+      memcpy(range.buffer, (void*)range.address, range.size);
+      range.valid = true;
+    }
+    countRead(0, total, 0);
+    return ranges.size();
+  }
+
+  size_t valid = 0;
+  size_t i = 0;
+  while (i < ranges.size()) {
+    if (ranges[i].size >= LARGE_RANGE_SIZE || !canReadVector) {
+      valid += readByPread(ranges[i]);
+      i++;
+      continue;
+    }
+    size_t end = i;
+    while (end < ranges.size() && end - i < IOV_MAX && ranges[end].size < LARGE_RANGE_SIZE) {
+      end++;
+    }
+    size_t numOfRead = readByVector(ranges, i, end);
+    if (!canReadVector) { // Not supported, retry with pread
+      continue;
+    }
+    valid += numOfRead;
+    // Stopped by the first range that is not readable
+    i += numOfRead;
+    if (i < end) {
+      ranges[i].valid = false;
+      i++;
+    }
+  }
+  return valid;
+}
+
+size_t MemIO::readByPread(MemRange& range) {
+  MemFdPtr fd = getMemFd();
+  ssize_t ret = !fd ? -1 : pread(*fd, range.buffer, range.size, (off_t)range.address);
+  countRead(0, ret > 0 ? ret : 0, 1);
+  range.valid = ret == (ssize_t)range.size;
+  return range.valid ? 1 : 0;
+}
+
+size_t MemIO::readByVector(vector<MemRange>& ranges, size_t start, size_t end) {
+  size_t count = end - start;
+  vector<struct iovec> local(count);
+  vector<struct iovec> remote(count);
+  for (size_t i = 0; i < count; i++) {
+    local[i].iov_base = ranges[start + i].buffer;
+    local[i].iov_len = ranges[start + i].size;
+    remote[i].iov_base = (void*)ranges[start + i].address;
+    remote[i].iov_len = ranges[start + i].size;
+  }
+
+  ssize_t ret = process_vm_readv(pid, local.data(), count, remote.data(), count, 0);
+  countRead(0, ret > 0 ? ret : 0, 1);
+  if (ret == -1) {
+    if (errno == ENOSYS || errno == EPERM) {
+      canReadVector = false;
+    }
+    return 0;
+  }
+
+  // Partial read never splits a range
+  size_t numOfRead = 0;
+  for (size_t i = 0; i < count && (size_t)ret >= ranges[start + i].size; i++) {
+    ret -= ranges[start + i].size;
+    ranges[start + i].valid = true;
+    numOfRead++;
+  }
+  return numOfRead;
+}
+
+size_t MemIO::write(vector<MemRange>& ranges) {
+  if (!pid) {
+    for (auto& range : ranges) {
+      memcpy((void*)range.address, range.buffer, range.size);
+      range.valid = true;
+    }
+    return ranges.size();
+  }
+
+  size_t valid = 0;
+  size_t i = 0;
+  while (i < ranges.size()) {
+    if (!canWriteVector) {
+      valid += writeByPwrite(ranges[i]);
+      i++;
+      continue;
+    }
+    size_t end = std::min(ranges.size(), i + IOV_MAX);
+    size_t numOfWritten = writeByVector(ranges, i, end);
+    if (!canWriteVector) { // Not supported, retry with pwrite
+      continue;
+    }
+    valid += numOfWritten;
+    i += numOfWritten;
+    if (i < end) { // Stopped by the range, such as read-only page
+      valid += writeByPwrite(ranges[i]);
+      i++;
+    }
+  }
+  return valid;
+}
+
+size_t MemIO::writeByPwrite(MemRange& range) {
+  MemFdPtr fd = getMemFd();
+  ssize_t ret = !fd ? -1 : pwrite(*fd, range.buffer, range.size, (off_t)range.address);
+  syscalls++;
+  range.valid = ret == (ssize_t)range.size;
+  return range.valid ? 1 : 0;
+}
+
+size_t MemIO::writeByVector(vector<MemRange>& ranges, size_t start, size_t end) {
+  size_t count = end - start;
+  vector<struct iovec> local(count);
+  vector<struct iovec> remote(count);
+  for (size_t i = 0; i < count; i++) {
+    local[i].iov_base = ranges[start + i].buffer;
+    local[i].iov_len = ranges[start + i].size;
+    remote[i].iov_base = (void*)ranges[start + i].address;
+    remote[i].iov_len = ranges[start + i].size;
+  }
+
+  ssize_t ret = process_vm_writev(pid, local.data(), count, remote.data(), count, 0);
+  syscalls++;
+  if (ret == -1) {
+    if (errno == ENOSYS || errno == EPERM) {
+      canWriteVector = false;
+    }
+    return 0;
+  }
+
+  size_t numOfWritten = 0;
+  for (size_t i = 0; i < count && (size_t)ret >= ranges[start + i].size; i++) {
+    ret -= ranges[start + i].size;
+    ranges[start + i].valid = true;
+    numOfWritten++;
+  }
+  return numOfWritten;
+}
+
+MemIOStats MemIO::getStats() {
+  return MemIOStats { bytesNeeded, bytesRead, syscalls };
+}
+
+MemIOStats MemIO::getThreadStats() {
+  return threadStats;
+}
+
+void MemIO::countRead(size_t needed, size_t read, size_t calls) {
+  bytesNeeded += needed;
+  bytesRead += read;
+  syscalls += calls;
+  threadStats.bytesNeeded += needed;
+  threadStats.bytesRead += read;
+  threadStats.syscalls += calls;
+}
+
+void MemIO::resetStats() {
+  bytesNeeded = 0;
+  bytesRead = 0;
+  syscalls = 0;
+}
+
+MemIO::MemFdPtr MemIO::getMemFd() {
+  std::lock_guard<std::mutex> lock(memFdMutex);
+  if (!memFd) {
+    // Read-write, so that the same descriptor is used for pwrite
+    string filename = "/proc/" + to_string(pid) + "/mem";
+    int fd = open(filename.c_str(), O_RDWR);
+    if (fd == -1) {
+      fd = getMem(pid);
+    }
+    if (fd == -1) {
+      return NULL;
+    }
+    memFd = MemFdPtr(new int(fd), [](int* fd) {
+        close(*fd);
+        delete fd;
+      });
+  }
+  return memFd;
+}
+
 MemPtr MemIO::readDirect(Address addr, size_t size) {
   MemPtr mem = MemPtr(new Mem(addr, size));
   return mem;
@@ -102,7 +330,7 @@ void MemIO::writeProcess(Address addr, MemPtr mem, size_t size) {
   long word;
   for (int i = 0; i < psize; i += sizeof(long)) {
     errno = 0;
-    word = ptrace(PTRACE_PEEKDATA, pid, (Byte*)(addr) + i, NULL);
+    word = ptrace(PTRACE_PEEKDATA, (pid_t)pid, (Byte*)(addr) + i, NULL);
 
     if(errno) {
       printf("PEEKDATA error: %p, %s\n", (void*)addr, strerror(errno));
@@ -121,7 +349,7 @@ void MemIO::writeProcess(Address addr, MemPtr mem, size_t size) {
     // Thus, the best solution is peek first, then only over write the position
     // Therefore, the value should be the WORD size.
 
-    if (ptrace(PTRACE_POKEDATA, pid, (Byte*)(addr) + i, *(long*)((Byte*)buf + i) ) == -1L) {
+    if (ptrace(PTRACE_POKEDATA, (pid_t)pid, (Byte*)(addr) + i, *(long*)((Byte*)buf + i) ) == -1L) {
       printf("POKEDATA error: %s\n", strerror(errno));
     }
   }
@@ -1,10 +1,13 @@
 #include <cstdio>
 #include <iostream>
 #include <algorithm>
+#include <map>
 
 #include "mem/MemList.hpp"
 #include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
 #include "mem/Sem.hpp"
+#include "mem/ReadPlanner.hpp"
 
 using namespace std;
 
@@ -42,6 +45,44 @@ string MemList::getValue(int index) {
   return pem->getValue(pem->getScanType());
 }
 
+vector<string> MemList::getValues(size_t count) {
+  count = std::min(count, list.size());
+  vector<string> values(count);
+  if (!count) {
+    return values;
+  }
+
+  // Each process is read in its own batch
+  map<MemIO*, vector<size_t>> indicesByMemIO;
+  for (size_t i = 0; i < count; i++) {
+    indicesByMemIO[static_cast<Pem*>(list[i].get())->getMemIO()].push_back(i);
+  }
+  for (auto& indices : indicesByMemIO) {
+    ReadPlanner planner;
+    for (auto i : indices.second) {
+      planner.add(list[i]->getAddress(), list[i]->getSize());
+    }
+    planner.read(indices.first);
+
+    for (size_t j = 0; j < indices.second.size(); j++) {
+      size_t i = indices.second[j];
+      Byte* data = planner.getData(j);
+      if (!data) {
+        continue;
+      }
+      Pem* pem = static_cast<Pem*>(list[i].get());
+      try {
+        values[i] = Pem::bytesToString(data, list[i]->getSize(), pem->getScanType());
+      } catch (const MedException &ex) {}
+    }
+  }
+  return values;
+}
+
+vector<string> MemList::getValues() {
+  return getValues(list.size());
+}
+
 void MemList::dump(int index, bool newline) {
   list[index]->dump(newline);
 }
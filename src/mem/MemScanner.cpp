@@ -1,17 +1,21 @@
 #include <iostream>
 #include <unistd.h> //getpagesize()
 #include <utility>
+#include <algorithm>
+#include <cstring>
 
 #include "mem/MemScanner.hpp"
 #include "med/MemOperator.hpp"
 #include "mem/Pem.hpp"
 #include "mem/MemList.hpp"
+#include "mem/ReadPlanner.hpp"
 
 using namespace std;
 
 const int STEP = 1;
 const int CHUNK_SIZE = 128;
 const int ADDRESS_SORTABLE_SIZE = 800;
+const size_t RECORD_WINDOW_SIZE = 64 * 1024; // Multiple of the page size
 
 MemScanner::MemScanner() {
   pid = 0;
@@ -33,8 +37,9 @@ MemScanner::~MemScanner() {
 
 void MemScanner::initialize() {
   threadManager = new ThreadManager();
-  threadManager->setMaxThreads(8);
+  threadManager->setMaxThreads(DEFAULT_MAX_THREADS);
   memio = new MemIO();
+  progress = ScanProgressPtr(new ScanProgress());
   scope = new AddressPair(0, 0);
 }
 
@@ -125,6 +130,25 @@ vector<MemPtr> MemScanner::filterUnknownInner(const vector<MemPtr>& list,
   return newList;
 }
 
+vector<MemPtr> MemScanner::filterDeltaInner(const vector<MemPtr>& list, DeltaMatcher& matcher) {
+  int size = matcher.getSize();
+  string scanType = scanTypeToString(matcher.getScanType());
+  vector<MemPtr> newList;
+  for (size_t i = 0; i < list.size(); i++) {
+    MemPtr mem = memio->read(list[i]->getAddress(), size);
+    PemPtr pem = static_pointer_cast<Pem>(list[i]);
+    Byte* oldValue = pem->recallValuePtr();
+
+    if (oldValue && matcher.match(mem->getData(), oldValue)) {
+      PemPtr newPem = Pem::convertToPemPtr(mem, memio);
+      newPem->setScanType(scanType);
+      newPem->rememberValue(mem->getData(), size);
+      newList.push_back(newPem);
+    }
+  }
+  return newList;
+}
+
 vector<MemPtr> MemScanner::scan(Operands& operands,
                                 int size,
                                 const string& scanType,
@@ -145,20 +169,26 @@ vector<MemPtr> MemScanner::scanByMaps(Operands& operands,
                                       bool fastScan,
                                       Integers lastDigits) {
   vector<MemPtr> list;
+  stats.begin("scan", threadManager->getMaxThreads());
 
   Maps maps = getMaps(pid);
   if (hasScope()) {
     maps.trimByScope(*scope);
   }
+  stats.addPages(0, excludeRanges(maps));
+  progress->begin(maps.getTotalSize(), maps.size());
   int memFd = getMem(pid);
   MemIO* memio = getMemIO();
 
   auto& mutex = listMutex;
+  auto& stats = this->stats;
+  ScanProgress* progress = this->progress.get();
   std::mutex fdMutex;
 
   for (size_t i = 0; i < maps.size(); i++) {
     TMTask* fn = new TMTask();
-    *fn = [memio, &mutex, &list, &maps, i, memFd, &fdMutex, &operands, size, scanType, op, fastScan, lastDigits]() {
+    *fn = [memio, &mutex, &list, &maps, i, memFd, &fdMutex, &operands, size, scanType, op, &stats, fastScan, lastDigits, progress]() {
+      int64_t taskStart = ScanStatsRecorder::now();
       scanMap(ScanParams {
           .memio = memio,
           .mutex = mutex,
@@ -171,9 +201,12 @@ vector<MemPtr> MemScanner::scanByMaps(Operands& operands,
           .size = size,
           .scanType = scanType,
           .op = op,
+          .stats = stats,
           .fastScan = fastScan,
-          .lastDigits = lastDigits
+          .lastDigits = lastDigits,
+          .progress = progress
         });
+      stats.addTask(ScanStatsRecorder::now() - taskStart);
     };
     threadManager->queueTask(fn);
   }
@@ -183,28 +216,38 @@ vector<MemPtr> MemScanner::scanByMaps(Operands& operands,
   close(memFd);
 
   if (list.size() <= ADDRESS_SORTABLE_SIZE) {
-    return MemList::sortByAddress(list);
+    int64_t sortStart = ScanStatsRecorder::now();
+    list = MemList::sortByAddress(list);
+    stats.addMaterialize(ScanStatsRecorder::now() - sortStart);
   }
+  stats.end(list.size());
   return list;
 }
 
 vector<MemPtr> MemScanner::scanByMaps(ScanCommand &scanCommand, Integers lastDigits, bool fastScan) {
   vector<MemPtr> list;
+  stats.begin("scan", threadManager->getMaxThreads());
 
   Maps maps = getMaps(pid);
   if (hasScope()) {
     maps.trimByScope(*scope);
   }
+  stats.addPages(0, excludeRanges(maps));
+  progress->begin(maps.getTotalSize(), maps.size());
   int memFd = getMem(pid);
   MemIO* memio = getMemIO();
 
   auto& mutex = listMutex;
+  auto& stats = this->stats;
+  ScanProgress* progress = this->progress.get();
   std::mutex fdMutex;
 
   for (size_t i = 0; i < maps.size(); i++) {
     TMTask* fn = new TMTask();
-    *fn = [memio, &mutex, &list, &maps, i, memFd, &fdMutex, &scanCommand, lastDigits, fastScan]() {
-      scanMap(memio, mutex, list, maps, i, memFd, fdMutex, scanCommand, lastDigits, fastScan);
+    *fn = [memio, &mutex, &list, &maps, i, memFd, &fdMutex, &scanCommand, &stats, progress, lastDigits, fastScan]() {
+      int64_t taskStart = ScanStatsRecorder::now();
+      scanMap(memio, mutex, list, maps, i, memFd, fdMutex, scanCommand, stats, progress, lastDigits, fastScan);
+      stats.addTask(ScanStatsRecorder::now() - taskStart);
     };
     threadManager->queueTask(fn);
   }
@@ -214,18 +257,45 @@ vector<MemPtr> MemScanner::scanByMaps(ScanCommand &scanCommand, Integers lastDig
   close(memFd);
 
   if (list.size() <= ADDRESS_SORTABLE_SIZE) {
-    return MemList::sortByAddress(list);
+    int64_t sortStart = ScanStatsRecorder::now();
+    list = MemList::sortByAddress(list);
+    stats.addMaterialize(ScanStatsRecorder::now() - sortStart);
   }
+  stats.end(list.size());
   return list;
 }
 
 vector<MemPtr>& MemScanner::saveSnapshot(const vector<MemPtr>& baseList) {
   snapshot.clear();
+  stats.begin("snapshot", 1);
+  int64_t taskStart = ScanStatsRecorder::now();
   if (hasScope()) {
-    return saveSnapshotByScope();
+    saveSnapshotByScope();
   }
   else {
-    return saveSnapshotByList(baseList);
+    saveSnapshotByList(baseList);
+  }
+  stats.addTask(ScanStatsRecorder::now() - taskStart);
+  stats.end(snapshot.size());
+  return snapshot;
+}
+
+namespace {
+  /**
+   * Read the page by the shared /proc/pid/mem, without ptrace attach.
+   * @return NULL if not readable
+   */
+  MemPtr readSnapshotPage(MemIO* memio, Address address, size_t size, ScanStatsRecorder& stats) {
+    MemPtr mem = MemPtr(new Mem(size));
+    mem->setAddress(address);
+
+    MemIOStats before = MemIO::getThreadStats();
+    int64_t readStart = ScanStatsRecorder::now();
+    bool valid = memio->read(address, mem->getData(), size) == (ssize_t)size;
+    MemIOStats after = MemIO::getThreadStats();
+    stats.addRead(after.bytesRead - before.bytesRead, after.syscalls - before.syscalls, ScanStatsRecorder::now() - readStart);
+    stats.addPages(valid ? 1 : 0, valid ? 0 : 1);
+    return valid ? mem : NULL;
   }
 }
 
@@ -239,7 +309,7 @@ vector<MemPtr>& MemScanner::saveSnapshotByList(const vector<MemPtr>& baseList) {
   MemIO* memio = getMemIO();
 
   for (size_t i = 0; i < maps.size(); i++) {
-    saveSnapshotMap(memio, snapshot, maps, i);
+    saveSnapshotMap(memio, snapshot, maps, i, stats);
   }
   return snapshot;
 }
@@ -250,16 +320,54 @@ vector<MemPtr>& MemScanner::saveSnapshotByScope() {
   auto start = scope->first;
   auto end = scope->second;
   for (Address j = start; j < end; j += size) {
-    try {
-      MemPtr mem = memio->read(j, size);
+    MemPtr mem = readSnapshotPage(memio, j, size, stats);
+    if (mem) {
       snapshot.push_back(mem);
-    } catch(MedException& ex) {
-      cerr << ex.getMessage() << endl;
     }
   }
   return snapshot;
 }
 
+namespace {
+  /**
+   * Read the page by the shared fd, the time waiting for the fd is counted as lock wait.
+   */
+  bool readPage(int fd, std::mutex& fdMutex, Address address, Byte* page, ScanStatsRecorder& stats) {
+    int64_t lockStart = ScanStatsRecorder::now();
+    std::lock_guard<std::mutex> lock(fdMutex);
+    int64_t readStart = ScanStatsRecorder::now();
+    stats.addLockWait(readStart - lockStart);
+
+    ssize_t ret = -1;
+    size_t syscalls = 1;
+    if (lseek(fd, address, SEEK_SET) != -1) {
+      ret = read(fd, page, getpagesize());
+      syscalls++;
+    }
+    stats.addRead(ret > 0 ? ret : 0, syscalls, ScanStatsRecorder::now() - readStart);
+    stats.addPages(ret == -1 ? 0 : 1, ret == -1 ? 1 : 0);
+    return ret != -1;
+  }
+
+  /**
+   * Append the matches of a page under the lock once, instead of locking for each match.
+   */
+  void appendToList(std::mutex& mutex, vector<MemPtr>& list, vector<MemPtr>& found, ScanStatsRecorder& stats, ScanProgress* progress) {
+    if (found.size() == 0) {
+      return;
+    }
+    int64_t lockStart = ScanStatsRecorder::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t appendStart = ScanStatsRecorder::now();
+    stats.addLockWait(appendStart - lockStart);
+    list.insert(list.end(), found.begin(), found.end());
+    if (progress) {
+      progress->addPartial(found); // Under the lock, so that the partial results are in the order of the list
+    }
+    stats.addMaterialize(ScanStatsRecorder::now() - appendStart);
+  }
+}
+
 void MemScanner::scanMap(ScanParams params) {
   MemIO* memio = params.memio;
   std::mutex& mutex = params.mutex;
@@ -272,30 +380,30 @@ void MemScanner::scanMap(ScanParams params) {
   int size = params.size;
   const string& scanType = params.scanType;
   const ScanParser::OpType& op = params.op;
+  ScanStatsRecorder& stats = params.stats;
   bool fastScan = params.fastScan;
   Integers lastDigits = params.lastDigits;
+  ScanProgress* progress = params.progress;
 
   auto& pairs = maps.getMaps();
   auto& pair = pairs[mapIndex];
   for (Address j = std::get<0>(pair); j < std::get<1>(pair); j += getpagesize()) {
+    if (progress && progress->isCancelled()) {
+      return;
+    }
     Byte* page = new Byte[getpagesize()]; //For block of memory
 
-    fdMutex.lock();
-    if (lseek(fd, j, SEEK_SET) == -1) {
-      delete[] page;
-      fdMutex.unlock();
-      continue;
+    if (readPage(fd, fdMutex, j, page, stats)) {
+      scanPage(memio, mutex, list, page, j, operands, size, scanType, op, stats, progress, fastScan, lastDigits);
     }
-    if (read(fd, page, getpagesize()) == -1) {
-      delete[] page;
-      fdMutex.unlock();
-      continue;
-    }
-    fdMutex.unlock();
-
-    scanPage(memio, mutex, list, page, j, operands, size, scanType, op, fastScan, lastDigits);
 
     delete[] page;
+    if (progress) {
+      progress->addBytes(getpagesize());
+    }
+  }
+  if (progress) {
+    progress->addRegion();
   }
 }
 
@@ -307,46 +415,45 @@ void MemScanner::scanMap(MemIO* memio,
                          int fd,
                          std::mutex& fdMutex,
                          ScanCommand &scanCommand,
+                         ScanStatsRecorder& stats,
+                         ScanProgress* progress,
                          Integers lastDigits,
                          bool fastScan) {
   auto& pairs = maps.getMaps();
   auto& pair = pairs[mapIndex];
   for (Address j = std::get<0>(pair); j < std::get<1>(pair); j += getpagesize()) {
+    if (progress && progress->isCancelled()) {
+      return;
+    }
     Byte* page = new Byte[getpagesize()]; //For block of memory
 
-    fdMutex.lock();
-    if (lseek(fd, j, SEEK_SET) == -1) {
-      delete[] page;
-      fdMutex.unlock();
-      continue;
+    if (readPage(fd, fdMutex, j, page, stats)) {
+      scanPage(memio, mutex, list, page, j, scanCommand, stats, progress, lastDigits, fastScan);
     }
-    if (read(fd, page, getpagesize()) == -1) {
-      delete[] page;
-      fdMutex.unlock();
-      continue;
-    }
-    fdMutex.unlock();
-
-    scanPage(memio, mutex, list, page, j, scanCommand, lastDigits, fastScan);
 
     delete[] page;
+    if (progress) {
+      progress->addBytes(getpagesize());
+    }
+  }
+  if (progress) {
+    progress->addRegion();
   }
 }
 
 void MemScanner::saveSnapshotMap(MemIO* memio,
                                  vector<MemPtr>& snapshot,
                                  Maps& maps,
-                                 int mapIndex) {
+                                 int mapIndex,
+                                 ScanStatsRecorder& stats) {
   int size = getpagesize();
 
   auto& pairs = maps.getMaps();
   auto& pair = pairs[mapIndex];
   for (Address j = std::get<0>(pair); j < std::get<1>(pair); j += size) {
-    try {
-      MemPtr mem = memio->read(j, size);
+    MemPtr mem = readSnapshotPage(memio, j, size, stats);
+    if (mem) {
       snapshot.push_back(mem);
-    } catch(MedException& ex) {
-      cerr << ex.getMessage() << endl;
     }
   }
 }
@@ -372,6 +479,140 @@ bool skipAddressByLastDigits(long address, Integers lastDigits) {
   return !matched;
 }
 
+namespace {
+  const size_t FILTER_CHUNK_SIZE = 4096;
+
+  vector<size_t> indicesByAddress(const vector<MemPtr>& list) {
+    vector<size_t> indices(list.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+      indices[i] = i;
+    }
+    bool sorted = std::is_sorted(list.begin(), list.end(), [](const MemPtr& a, const MemPtr& b) {
+        return a->getAddress() < b->getAddress();
+      });
+    if (!sorted) {
+      std::sort(indices.begin(), indices.end(), [&list](size_t a, size_t b) {
+          return list[a]->getAddress() < list[b]->getAddress();
+        });
+    }
+    return indices;
+  }
+
+  template<typename Predicate>
+  void filterByPlanner(MemIO* memio,
+                       const vector<MemPtr>& list,
+                       const vector<size_t>& indices,
+                       size_t begin,
+                       size_t end,
+                       size_t size,
+                       Predicate& predicate,
+                       vector<MemPtr>& newList,
+                       vector<Byte>& newValues,
+                       ScanStatsRecorder& stats) {
+    ReadPlanner planner;
+    for (size_t i = begin; i < end; i++) {
+      planner.add(list[indices[i]]->getAddress(), size);
+    }
+    MemIOStats before = MemIO::getThreadStats();
+    int64_t readStart = ScanStatsRecorder::now();
+    planner.read(memio);
+    int64_t compareStart = ScanStatsRecorder::now();
+    MemIOStats after = MemIO::getThreadStats();
+    stats.addRead(after.bytesRead - before.bytesRead, after.syscalls - before.syscalls, compareStart - readStart);
+
+    size_t count = end - begin;
+    vector<Byte> mask(count);
+    for (size_t i = 0; i < count; i++) {
+      Byte* value = planner.getData(i);
+      mask[i] = value && predicate(static_cast<Pem*>(list[indices[begin + i]].get()), value); // NULL if memory not available
+    }
+    int64_t materializeStart = ScanStatsRecorder::now();
+    stats.addCompare(materializeStart - compareStart);
+
+    for (size_t i = 0; i < count; i++) {
+      if (!mask[i]) {
+        continue;
+      }
+      newList.push_back(list[indices[begin + i]]);
+      newValues.insert(newValues.end(), planner.getData(i), planner.getData(i) + size);
+    }
+    stats.addMaterialize(ScanStatsRecorder::now() - materializeStart);
+  }
+
+  /**
+   * Filter the list by reading the values in address order, in bulk, and compare in place.
+   * Each task collects its own results, which are concatenated at the end,
+   * so the result is sorted by address.
+   * If cancelled, the chunks not yet filtered are passed through unchecked, so no candidate is lost.
+   * The values are remembered only after all the chunks are filtered, so a cancelled filter
+   * leaves the remembered values of the list unchanged.
+   */
+  template<typename Predicate>
+  vector<MemPtr> filterByStream(ThreadManager* threadManager,
+                                MemIO* memio,
+                                ScanStatsRecorder& stats,
+                                ScanProgress* progress,
+                                const vector<MemPtr>& list,
+                                size_t size,
+                                const string& scanType,
+                                Predicate predicate) {
+    stats.begin("filter", threadManager->getMaxThreads());
+    if (size == 0) {
+      stats.end(0);
+      return vector<MemPtr>();
+    }
+    vector<size_t> indices = indicesByAddress(list);
+    size_t numOfChunks = (indices.size() + FILTER_CHUNK_SIZE - 1) / FILTER_CHUNK_SIZE;
+    vector<vector<MemPtr>> results(numOfChunks);
+    vector<vector<Byte>> values(numOfChunks); // Of the results, to be remembered
+    progress->begin(indices.size() * size, numOfChunks);
+
+    for (size_t i = 0; i < numOfChunks; i++) {
+      TMTask* fn = new TMTask();
+      *fn = [memio, &stats, progress, &list, &indices, &results, &values, i, size, &scanType, &predicate]() {
+        size_t begin = i * FILTER_CHUNK_SIZE;
+        size_t end = std::min(begin + FILTER_CHUNK_SIZE, indices.size());
+        if (progress->isCancelled()) {
+          for (size_t j = begin; j < end; j++) {
+            results[i].push_back(list[indices[j]]);
+          }
+          return;
+        }
+        int64_t taskStart = ScanStatsRecorder::now();
+        filterByPlanner(memio, list, indices, begin, end, size, predicate, results[i], values[i], stats);
+        stats.addTask(ScanStatsRecorder::now() - taskStart);
+        progress->addPartial(results[i]);
+        progress->addBytes((end - begin) * size);
+        progress->addRegion();
+      };
+      threadManager->queueTask(fn);
+    }
+    threadManager->start();
+    threadManager->clear();
+
+    int64_t concatStart = ScanStatsRecorder::now();
+    size_t total = 0;
+    for (auto& result : results) {
+      total += result.size();
+    }
+    vector<MemPtr> newList;
+    newList.reserve(total);
+    bool remember = !progress->isCancelled();
+    for (size_t i = 0; i < numOfChunks; i++) {
+      auto& result = results[i];
+      for (size_t j = 0; remember && j < result.size(); j++) {
+        Pem* pem = static_cast<Pem*>(result[j].get());
+        pem->setScanType(scanType);
+        pem->rememberValue(&values[i][j * size], size);
+      }
+      newList.insert(newList.end(), result.begin(), result.end());
+    }
+    stats.addMaterialize(ScanStatsRecorder::now() - concatStart);
+    stats.end(newList.size());
+    return newList;
+  }
+}
+
 // @deprecated
 void MemScanner::scanPage(MemIO* memio,
                           std::mutex& mutex,
@@ -382,9 +623,13 @@ void MemScanner::scanPage(MemIO* memio,
                           int size,
                           const string& scanType,
                           const ScanParser::OpType& op,
+                          ScanStatsRecorder& stats,
+                          ScanProgress* progress,
                           bool fastScan,
                           Integers lastDigits) {
   int scanTypeSize = scanTypeToSize(scanType);
+  vector<MemPtr> found;
+  int64_t compareStart = ScanStatsRecorder::now();
   for (int k = 0; k <= getpagesize() - size; k += STEP) {
     long address = (Address)(start + k);
 
@@ -398,20 +643,17 @@ void MemScanner::scanPage(MemIO* memio,
 
     try {
       if (memCompare(page + k, size, operands, op)) {
-        MemPtr mem = memio->read((Address)(start + k), size);
-
-        PemPtr pem = Pem::convertToPemPtr(mem, memio);
+        PemPtr pem = PemPtr(new Pem((Address)(start + k), size, memio));
         pem->setScanType(scanType);
         pem->rememberValue(page + k, size);
-
-        mutex.lock();
-        list.push_back(pem);
-        mutex.unlock();
+        found.push_back(pem);
       }
     } catch(MedException& ex) {
       cerr << ex.getMessage() << endl;
     }
   }
+  stats.addCompare(ScanStatsRecorder::now() - compareStart);
+  appendToList(mutex, list, found, stats, progress);
 }
 
 void MemScanner::scanPage(MemIO* memio,
@@ -420,86 +662,203 @@ void MemScanner::scanPage(MemIO* memio,
                           Byte* page,
                           Address start,
                           ScanCommand &scanCommand,
+                          ScanStatsRecorder& stats,
+                          ScanProgress* progress,
                           Integers lastDigits,
                           bool fastScan) {
   size_t size = scanCommand.getSize();
   string scanType = scanCommand.getFirstScanType();
   int scanTypeSize = scanTypeToSize(scanType);
+  size_t pageSize = getpagesize();
+  if (size > pageSize) {
+    return;
+  }
 
-  for (size_t k = 0; k <= getpagesize() - size; k += STEP) {
-    long address = (Address)(start + k);
+  // Page is aligned, so fast scan is the same as stepping by the type size
+  size_t step = STEP;
+  if (scanType != SCAN_TYPE_STRING && fastScan && scanTypeSize > 0) {
+    step = scanTypeSize;
+  }
+  size_t count = (pageSize - size) / step + 1;
+  vector<Byte> mask(count);
+  int64_t compareStart = ScanStatsRecorder::now();
+  size_t matched = scanCommand.matchBlock(page, count, step, mask.data());
+  int64_t materializeStart = ScanStatsRecorder::now();
+  stats.addCompare(materializeStart - compareStart);
+  if (!matched) {
+    return;
+  }
 
-    if (scanType != SCAN_TYPE_STRING &&
-        skipAddressByFastScan(address, scanTypeSize, fastScan)) {
+  vector<MemPtr> found;
+  found.reserve(matched);
+  for (size_t i = 0; i < count; i++) {
+    if (!mask[i]) {
       continue;
     }
+    size_t k = i * step;
+    long address = (Address)(start + k);
+
     if (skipAddressByLastDigits(address, lastDigits)) {
       continue;
     }
 
-    try {
-      if (scanCommand.match(page + k)) {
-        MemPtr mem = memio->read(address, size);
-
-        PemPtr pem = Pem::convertToPemPtr(mem, memio);
-        pem->setScanType(scanCommand.getFirstScanType());
-        pem->rememberValue(page + k, size);
-
-        mutex.lock();
-        list.push_back(pem);
-        mutex.unlock();
-      }
-    } catch(MedException& ex) {
-      cerr << ex.getMessage() << endl;
-    }
+    PemPtr pem = PemPtr(new Pem(address, size, memio));
+    pem->setScanType(scanType);
+    pem->rememberValue(page + k, size);
+    found.push_back(pem);
   }
+  stats.addMaterialize(ScanStatsRecorder::now() - materializeStart);
+  appendToList(mutex, list, found, stats, progress);
 }
 
-vector<MemPtr> MemScanner::filter(const vector<MemPtr>& list,
-                                  Operands& operands,
-                                  int size,
-                                  const string& scanType,
-                                  const ScanParser::OpType& op) {
-  vector<MemPtr> newList;
+vector<MemPtr> MemScanner::scanRecords(RecordMatcher& matcher) {
+  vector<MemPtr> list;
+  stats.begin("record scan", threadManager->getMaxThreads());
+
+  Maps maps = getMaps(pid);
+  if (hasScope()) {
+    maps.trimByScope(*scope);
+  }
+  stats.addPages(0, excludeRanges(maps));
+  progress->begin(maps.getTotalSize(), maps.size());
+  MemIO* memio = getMemIO();
 
   auto& mutex = listMutex;
+  auto& stats = this->stats;
+  ScanProgress* progress = this->progress.get();
 
-  for (size_t i = 0; i < list.size(); i += CHUNK_SIZE) {
+  for (size_t i = 0; i < maps.size(); i++) {
     TMTask* fn = new TMTask();
-    *fn = [&mutex, &list, &newList, i, &operands, size, scanType, op]() {
-            filterByChunk(mutex, list, newList, i, operands, size, scanType, op);
-          };
+    *fn = [memio, &mutex, &list, &maps, i, &matcher, &stats, progress]() {
+      int64_t taskStart = ScanStatsRecorder::now();
+      scanRecordMap(memio, mutex, list, maps, i, matcher, stats, progress);
+      stats.addTask(ScanStatsRecorder::now() - taskStart);
+    };
     threadManager->queueTask(fn);
   }
   threadManager->start();
   threadManager->clear();
 
-  if (newList.size() <= ADDRESS_SORTABLE_SIZE) {
-    return MemList::sortByAddress(newList);
+  if (list.size() <= ADDRESS_SORTABLE_SIZE) {
+    int64_t sortStart = ScanStatsRecorder::now();
+    list = MemList::sortByAddress(list);
+    stats.addMaterialize(ScanStatsRecorder::now() - sortStart);
   }
-  return newList;
+  stats.end(list.size());
+  return list;
 }
 
-vector<MemPtr> MemScanner::filter(const vector<MemPtr> &list,
-                                  ScanCommand &scanCommand) {
-  vector<MemPtr> newList;
+/**
+ * Stream the region by windows, each window overlaps the next by the span of a record.
+ * Every aligned address is matched as a record start, then the run of the matched records
+ * is counted for each phase of the stride, so a run continues across the windows.
+ * When a run reaches the minimum, its records are found, and each following record as the run grows.
+ */
+void MemScanner::scanRecordMap(MemIO* memio,
+                               std::mutex& mutex,
+                               vector<MemPtr>& list,
+                               Maps& maps,
+                               int mapIndex,
+                               RecordMatcher& matcher,
+                               ScanStatsRecorder& stats,
+                               ScanProgress* progress) {
+  auto& pair = maps.getMaps()[mapIndex];
+  Address start = std::get<0>(pair);
+  Address end = std::get<1>(pair);
+
+  size_t stride = matcher.getStride();
+  size_t span = matcher.getSpan();
+  size_t alignment = matcher.getAlignment();
+  size_t minRecords = matcher.getMinRecords();
+  string scanType = matcher.getScanType();
+  size_t size = scanTypeToSize(scanType);
+  size_t phases = stride / alignment;
+
+  vector<uint32_t> runs(phases, 0);
+  vector<Byte> buffer(RECORD_WINDOW_SIZE + span);
+  vector<Byte> mask(RECORD_WINDOW_SIZE / alignment);
+
+  for (Address window = start; window < end; window += RECORD_WINDOW_SIZE) {
+    if (progress && progress->isCancelled()) {
+      return;
+    }
+    size_t windowSize = std::min((Address)RECORD_WINDOW_SIZE, end - window);
+    size_t readSize = std::min((Address)RECORD_WINDOW_SIZE + span, end - window);
 
-  auto& mutex = listMutex;
+    int64_t readStart = ScanStatsRecorder::now();
+    ssize_t bytes = memio->read(window, buffer.data(), readSize);
+    stats.addRead(bytes > 0 ? bytes : 0, 1, ScanStatsRecorder::now() - readStart);
+    stats.addPages(bytes > 0 ? bytes / getpagesize() : 0, bytes > 0 ? 0 : windowSize / getpagesize());
 
-  for (size_t i = 0; i < list.size(); i += CHUNK_SIZE) {
-    TMTask* fn = new TMTask();
-    *fn = [&mutex, &list, &newList, i, &scanCommand]() {
-            filterByChunk(mutex, list, newList, i, scanCommand);
-          };
-    threadManager->queueTask(fn);
-  }
-  threadManager->start();
-  threadManager->clear();
+    size_t count = bytes >= (ssize_t)span ? (bytes - span) / alignment + 1 : 0;
+    count = std::min(count, windowSize / alignment);
+
+    int64_t compareStart = ScanStatsRecorder::now();
+    matcher.matchBlock(buffer.data(), count, alignment, mask.data());
 
-  if (newList.size() <= ADDRESS_SORTABLE_SIZE) {
-    return MemList::sortByAddress(newList);
+    vector<MemPtr> found;
+    auto addRecord = [&](Address address) {
+      Byte value[sizeof(uint64_t)];
+      if (address >= window) {
+        memcpy(value, buffer.data() + (address - window), size);
+      }
+      else if (memio->read(address, value, size) != (ssize_t)size) { // Record of the previous window
+        return;
+      }
+      PemPtr pem = PemPtr(new Pem(address, size, memio));
+      pem->setScanType(scanType);
+      pem->rememberValue(value, size);
+      found.push_back(pem);
+    };
+
+    size_t phase = ((window - start) / alignment) % phases;
+    for (size_t k = 0; k < count; k++, phase = phase + 1 == phases ? 0 : phase + 1) {
+      if (!mask[k]) {
+        runs[phase] = 0;
+        continue;
+      }
+      uint32_t run = ++runs[phase];
+      Address address = window + k * alignment;
+      if (run == minRecords) {
+        for (size_t r = minRecords; r > 0; r--) {
+          addRecord(address - (r - 1) * stride);
+        }
+      }
+      else if (run > minRecords) {
+        addRecord(address);
+      }
+    }
+    if (count < windowSize / alignment) { // Not readable to the end, the runs are broken
+      std::fill(runs.begin(), runs.end(), 0);
+    }
+    stats.addCompare(ScanStatsRecorder::now() - compareStart);
+    appendToList(mutex, list, found, stats, progress);
+
+    if (progress) {
+      progress->addBytes(windowSize);
+    }
+  }
+  if (progress) {
+    progress->addRegion();
   }
-  return newList;
+}
+
+vector<MemPtr> MemScanner::filter(const vector<MemPtr>& list,
+                                  Operands& operands,
+                                  int size,
+                                  const string& scanType,
+                                  const ScanParser::OpType& op) {
+  return filterByStream(threadManager, memio, stats, progress.get(), list, size, scanType, [&operands, size, op](Pem*, Byte* value) {
+      return memCompare(value, size, operands, op);
+    });
+}
+
+vector<MemPtr> MemScanner::filter(const vector<MemPtr> &list,
+                                  ScanCommand &scanCommand) {
+  return filterByStream(threadManager, memio, stats, progress.get(), list, scanCommand.getSize(), scanCommand.getFirstScanType(),
+                        [&scanCommand](Pem*, Byte* value) {
+                          return scanCommand.match(value);
+                        });
 }
 
 vector<MemPtr> MemScanner::filterUnknown(const vector<MemPtr>& list,
@@ -517,105 +876,30 @@ vector<MemPtr> MemScanner::filterUnknown(const vector<MemPtr>& list,
 vector<MemPtr> MemScanner::filterUnknownWithList(const vector<MemPtr>& list,
                                                  const string& scanType,
                                                  const ScanParser::OpType& op) {
-  vector<MemPtr> newList;
-
-  auto& mutex = listMutex;
-
-  for (size_t i = 0; i < list.size(); i += CHUNK_SIZE) {
-    TMTask* fn = new TMTask();
-    *fn = [&mutex, &list, &newList, i, scanType, op]() {
-      filterUnknownByChunk(mutex, list, newList, i, scanType, op);
-    };
-    threadManager->queueTask(fn);
-  }
-  threadManager->start();
-  threadManager->clear();
-
-  if (newList.size() <= ADDRESS_SORTABLE_SIZE) {
-    return MemList::sortByAddress(newList);
-  }
-  return newList;
+  int size = scanTypeToSize(scanType);
+  return filterByStream(threadManager, memio, stats, progress.get(), list, size, scanType, [size, op](Pem* pem, Byte* value) {
+      Byte* oldValue = pem->recallValuePtr();
+      return oldValue && memCompare(value, size, oldValue, size, op);
+    });
 }
 
-void MemScanner::filterByChunk(std::mutex& mutex,
-                               const vector<MemPtr>& list,
-                               vector<MemPtr>& newList,
-                               int listIndex,
-                               Operands& operands,
-                               int size,
-                               const string& scanType,
-                               const ScanParser::OpType& op) {
-  for (int i = listIndex; i < listIndex + CHUNK_SIZE && i < (int)list.size(); i++) {
-    PemPtr pem = static_pointer_cast<Pem>(list[i]);
-    BytePtr data;
-    try {
-      data = size > 1 ? pem->getValuePtr(size) : pem->getValuePtr();
-    } catch (const MedException &ex) { // Memory not available
-      continue;
-    }
-    if (memCompare(data.get(), size, operands, op)) {
-      pem->setScanType(scanType);
-      pem->rememberValue(data.get(), size);
-
-      mutex.lock();
-      newList.push_back(pem);
-      mutex.unlock();
-    }
+vector<MemPtr> MemScanner::filterDelta(const vector<MemPtr>& list,
+                                       DeltaMatcher& matcher,
+                                       bool fastScan) {
+  if (snapshot.size()) {
+    return filterSnapshot(matcher, fastScan);
   }
-}
-
-void MemScanner::filterByChunk(std::mutex& mutex,
-                               const vector<MemPtr>& list,
-                               vector<MemPtr>& newList,
-                               int listIndex,
-                               ScanCommand &scanCommand) {
-  size_t size = scanCommand.getSize();
-  for (int i = listIndex; i < listIndex + CHUNK_SIZE && i < (int)list.size(); i++) {
-    PemPtr pem = static_pointer_cast<Pem>(list[i]);
-    BytePtr data;
-    try {
-      data = size > 1 ? pem->getValuePtr(size) : pem->getValuePtr();
-    } catch(const MedException &ex) { // Memory not available
-      continue;
-    }
-    if (scanCommand.match(data.get())) {
-      pem->setScanType(scanCommand.getFirstScanType());
-      pem->rememberValue(data.get(), size);
-
-      mutex.lock();
-      newList.push_back(pem);
-      mutex.unlock();
-    }
+  else {
+    return filterDeltaWithList(list, matcher);
   }
 }
 
-void MemScanner::filterUnknownByChunk(std::mutex& mutex,
-                                      const vector<MemPtr>& list,
-                                      vector<MemPtr>& newList,
-                                      int listIndex,
-                                      const string& scanType,
-                                      const ScanParser::OpType& op) {
-  for (int i = listIndex; i < listIndex + CHUNK_SIZE && i < (int)list.size(); i++) {
-    int size = scanTypeToSize(scanType);
-    PemPtr pem = static_pointer_cast<Pem>(list[i]);
-    BytePtr data;
-    Byte* oldValue = NULL;
-    try {
-      data = pem->getValuePtr();
-      oldValue = pem->recallValuePtr();
-    } catch(const MedException &ex) {
-      continue;
-    }
-
-    if (memCompare(data.get(), size, oldValue, size, op)) {
-      pem->setScanType(scanType);
-      pem->rememberValue(data.get(), size);
-
-      mutex.lock();
-      newList.push_back(pem);
-      mutex.unlock();
-    }
-  }
+vector<MemPtr> MemScanner::filterDeltaWithList(const vector<MemPtr>& list, DeltaMatcher& matcher) {
+  string scanType = scanTypeToString(matcher.getScanType());
+  return filterByStream(threadManager, memio, stats, progress.get(), list, matcher.getSize(), scanType, [&matcher](Pem* pem, Byte* value) {
+      Byte* oldValue = pem->recallValuePtr();
+      return oldValue && matcher.match(value, oldValue);
+    });
 }
 
 Maps MemScanner::getInterestedMaps(Maps& maps, const vector<MemPtr>& list) {
@@ -640,16 +924,78 @@ Maps MemScanner::getInterestedMaps(Maps& maps, const vector<MemPtr>& list) {
   return interested;
 }
 
+namespace {
+  size_t totalSize(const vector<MemPtr>& blocks) {
+    size_t size = 0;
+    for (auto& block : blocks) {
+      size += block->getSize();
+    }
+    return size;
+  }
+}
+
 vector<MemPtr> MemScanner::filterSnapshot(const string& scanType, const ScanParser::OpType& op, bool fastScan) {
   vector<MemPtr> list;
-  for (size_t i = 0; i < snapshot.size(); i++) {
-    auto block = memio->read(snapshot[i]->getAddress(), snapshot[i]->getSize());
+  MemPtr block;
+  stats.begin("snapshot filter", 1);
+  int64_t taskStart = ScanStatsRecorder::now();
+  progress->begin(totalSize(snapshot), snapshot.size());
+  for (size_t i = 0; i < snapshot.size() && !progress->isCancelled(); i++) {
+    progress->addBytes(snapshot[i]->getSize());
+    progress->addRegion();
+    if (!readSnapshotBlock(snapshot[i], block)) {
+      continue;
+    }
+    int64_t compareStart = ScanStatsRecorder::now();
     compareBlocks(list, snapshot[i], block, scanType, op, fastScan);
+    stats.addCompare(ScanStatsRecorder::now() - compareStart);
   }
-  snapshot.clear();
+  if (!progress->isCancelled()) { // Otherwise kept, so that the filter can be done again
+    snapshot.clear();
+  }
+  stats.addTask(ScanStatsRecorder::now() - taskStart);
+  stats.end(list.size());
   return list;
 }
 
+vector<MemPtr> MemScanner::filterSnapshot(DeltaMatcher& matcher, bool fastScan) {
+  vector<MemPtr> list;
+  MemPtr block;
+  stats.begin("snapshot filter", 1);
+  int64_t taskStart = ScanStatsRecorder::now();
+  progress->begin(totalSize(snapshot), snapshot.size());
+  for (size_t i = 0; i < snapshot.size() && !progress->isCancelled(); i++) {
+    progress->addBytes(snapshot[i]->getSize());
+    progress->addRegion();
+    if (!readSnapshotBlock(snapshot[i], block)) {
+      continue;
+    }
+    compareBlocks(list, snapshot[i], block, matcher, fastScan);
+  }
+  if (!progress->isCancelled()) {
+    snapshot.clear();
+  }
+  stats.addTask(ScanStatsRecorder::now() - taskStart);
+  stats.end(list.size());
+  return list;
+}
+
+bool MemScanner::readSnapshotBlock(MemPtr& oldBlock, MemPtr& newBlock) {
+  size_t size = oldBlock->getSize();
+  if (!newBlock || newBlock->getSize() != size) { // Reuse the block for all pages
+    newBlock = MemPtr(new Mem(size));
+  }
+  newBlock->setAddress(oldBlock->getAddress());
+
+  MemIOStats before = MemIO::getThreadStats();
+  int64_t readStart = ScanStatsRecorder::now();
+  bool valid = memio->read(oldBlock->getAddress(), newBlock->getData(), size) == (ssize_t)size;
+  MemIOStats after = MemIO::getThreadStats();
+  stats.addRead(after.bytesRead - before.bytesRead, after.syscalls - before.syscalls, ScanStatsRecorder::now() - readStart);
+  stats.addPages(valid ? 1 : 0, valid ? 0 : 1);
+  return valid;
+}
+
 void MemScanner::compareBlocks(vector<MemPtr>& list,
                                MemPtr& oldBlock,
                                MemPtr& newBlock,
@@ -668,16 +1014,57 @@ void MemScanner::compareBlocks(vector<MemPtr>& list,
     }
 
     if (memCompare(newBlockPtr + i, size, oldBlockPtr + i, size, op)) {
-      MemPtr mem = memio->read(oldAddress, size);
-      PemPtr pem = Pem::convertToPemPtr(mem, memio);
+      PemPtr pem = PemPtr(new Pem(oldAddress, size, memio));
       pem->setScanType(scanType);
-      pem->rememberValue(mem->getData(), size);
+      pem->rememberValue(newBlockPtr + i, size);
 
       list.push_back(pem);
     }
   }
 }
 
+void MemScanner::compareBlocks(vector<MemPtr>& list,
+                               MemPtr& oldBlock,
+                               MemPtr& newBlock,
+                               DeltaMatcher& matcher,
+                               bool fastScan) {
+  size_t blockSize = oldBlock->getSize();
+  size_t size = matcher.getSize();
+
+  // Fast scan starts from the first aligned address, then steps by the type size
+  size_t step = fastScan ? size : STEP;
+  size_t offset = fastScan ? (size - oldBlock->getAddress() % size) % size : 0;
+  if (blockSize < offset + size) {
+    return;
+  }
+  size_t count = (blockSize - offset - size) / step + 1;
+  Byte* oldBlockPtr = oldBlock->getData() + offset;
+  Byte* newBlockPtr = newBlock->getData() + offset;
+
+  vector<Byte> mask(count);
+  int64_t compareStart = ScanStatsRecorder::now();
+  size_t matched = matcher.matchBlock(newBlockPtr, oldBlockPtr, count, step, mask.data());
+  int64_t materializeStart = ScanStatsRecorder::now();
+  stats.addCompare(materializeStart - compareStart);
+  if (!matched) {
+    return;
+  }
+
+  string scanType = scanTypeToString(matcher.getScanType());
+  for (size_t i = 0; i < count; i++) {
+    if (!mask[i]) {
+      continue;
+    }
+    Address address = oldBlock->getAddress() + offset + i * step;
+    PemPtr pem = PemPtr(new Pem(address, size, memio));
+    pem->setScanType(scanType);
+    pem->rememberValue(newBlockPtr + i * step, size);
+
+    list.push_back(pem);
+  }
+  stats.addMaterialize(ScanStatsRecorder::now() - materializeStart);
+}
+
 AddressPair* MemScanner::getScope() {
   return scope;
 }
@@ -697,3 +1084,43 @@ bool MemScanner::hasScope() {
 std::mutex& MemScanner::getListMutex() {
   return listMutex;
 }
+
+void MemScanner::setExcludedRanges(const AddressPairs& ranges) {
+  excludedRanges = ranges;
+}
+
+/**
+ * @return number of pages excluded
+ */
+size_t MemScanner::excludeRanges(Maps& maps) {
+  auto countPages = [&maps]() {
+    size_t pages = 0;
+    for (auto& pair : maps.getMaps()) {
+      pages += (pair.second - pair.first) / getpagesize();
+    }
+    return pages;
+  };
+  size_t before = countPages();
+  maps.exclude(excludedRanges);
+  return before - countPages();
+}
+
+ScanStats MemScanner::getStats() {
+  return stats.getStats();
+}
+
+void MemScanner::setProgress(ScanProgressPtr progress) {
+  this->progress = progress;
+}
+
+ScanProgressPtr MemScanner::getProgress() {
+  return progress;
+}
+
+void MemScanner::setMaxThreads(int num) {
+  threadManager->setMaxThreads(std::max(num, 1));
+}
+
+int MemScanner::getMaxThreads() {
+  return threadManager->getMaxThreads();
+}
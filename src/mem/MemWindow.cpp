@@ -0,0 +1,175 @@
+#include <cstring>
+
+#include "mem/MemWindow.hpp"
+
+using namespace std;
+
+MemWindow::MemWindow(MemIO* memio, size_t pageSize) {
+  this->memio = memio;
+  this->pageSize = pageSize;
+  prefetch = DEFAULT_PREFETCH;
+  maxPages = DEFAULT_MAX_PAGES;
+  viewStart = 0;
+  viewSize = 0;
+  generation = 0;
+}
+
+void MemWindow::setView(Address start, size_t size) {
+  viewStart = start;
+  viewSize = size;
+}
+
+Address MemWindow::getViewStart() {
+  return viewStart;
+}
+
+size_t MemWindow::getViewSize() {
+  return viewSize;
+}
+
+void MemWindow::setPrefetch(size_t pages) {
+  prefetch = pages;
+}
+
+void MemWindow::setMaxPages(size_t pages) {
+  maxPages = std::max(pages, (size_t)1);
+}
+
+Address MemWindow::pageOf(Address address) {
+  return address - address % pageSize;
+}
+
+size_t MemWindow::update() {
+  if (viewSize == 0) {
+    return 0;
+  }
+  generation++;
+
+  Address first = pageOf(viewStart);
+  Address last = pageOf(viewStart + viewSize - 1);
+  Address prefetchFirst = first >= prefetch * pageSize ? first - prefetch * pageSize : 0;
+  Address prefetchLast = last + prefetch * pageSize;
+
+  // The view is read every time, the prefetch pages only when not cached
+  vector<Address> addresses;
+  for (Address page = prefetchFirst; page <= prefetchLast; page += pageSize) {
+    if ((page >= first && page <= last) || !pages.count(page)) {
+      addresses.push_back(page);
+    }
+  }
+
+  vector<Byte> buffer(addresses.size() * pageSize);
+  vector<MemRange> ranges(addresses.size());
+  for (size_t i = 0; i < addresses.size(); i++) {
+    ranges[i] = MemRange { addresses[i], pageSize, buffer.data() + i * pageSize, false };
+  }
+  memio->read(ranges);
+
+  size_t numOfValid = 0;
+  for (auto& range : ranges) {
+    auto it = pages.find(range.address);
+    bool isNew = it == pages.end();
+    Page& page = pages[range.address];
+    page.usedAt = generation;
+    if (isNew) {
+      page.data.assign(range.buffer, range.buffer + pageSize);
+      page.changedAt.assign(pageSize, 0);
+      page.valid = range.valid;
+    }
+    else if (range.valid) {
+      if (page.valid && memcmp(page.data.data(), range.buffer, pageSize) != 0) {
+        for (size_t i = 0; i < pageSize; i++) {
+          if (page.data[i] != range.buffer[i]) {
+            page.changedAt[i] = generation;
+          }
+        }
+      }
+      memcpy(page.data.data(), range.buffer, pageSize);
+      page.valid = true;
+    }
+    else {
+      page.valid = false;
+    }
+    numOfValid += range.valid;
+  }
+
+  evict(prefetchFirst, prefetchLast);
+  return numOfValid;
+}
+
+/**
+ * Remove the least recently used pages outside the range, until within the max pages
+ */
+void MemWindow::evict(Address first, Address last) {
+  while (pages.size() > maxPages) {
+    auto oldest = pages.end();
+    for (auto it = pages.begin(); it != pages.end(); ++it) {
+      if (it->first >= first && it->first <= last) {
+        continue;
+      }
+      if (oldest == pages.end() || it->second.usedAt < oldest->second.usedAt) {
+        oldest = it;
+      }
+    }
+    if (oldest == pages.end()) {
+      return;
+    }
+    pages.erase(oldest);
+  }
+}
+
+MemWindow::Page* MemWindow::findPage(Address address) {
+  auto it = pages.find(pageOf(address));
+  if (it == pages.end() || !it->second.valid) {
+    return NULL;
+  }
+  return &it->second;
+}
+
+bool MemWindow::get(Address address, Byte* buffer, size_t size) {
+  while (size > 0) {
+    Page* page = findPage(address);
+    if (!page) {
+      return false;
+    }
+    size_t offset = address - pageOf(address);
+    size_t length = std::min(size, pageSize - offset);
+    memcpy(buffer, page->data.data() + offset, length);
+    address += length;
+    buffer += length;
+    size -= length;
+  }
+  return true;
+}
+
+bool MemWindow::isReadable(Address address) {
+  return findPage(address) != NULL;
+}
+
+uint32_t MemWindow::getAge(Address address) {
+  Page* page = findPage(address);
+  if (!page) {
+    return NEVER_CHANGED;
+  }
+  uint32_t changedAt = page->changedAt[address - pageOf(address)];
+  if (changedAt == 0) {
+    return NEVER_CHANGED;
+  }
+  return generation - changedAt;
+}
+
+uint32_t MemWindow::getGeneration() {
+  return generation;
+}
+
+size_t MemWindow::getPageSize() {
+  return pageSize;
+}
+
+size_t MemWindow::getNumOfPages() {
+  return pages.size();
+}
+
+void MemWindow::clear() {
+  pages.clear();
+}
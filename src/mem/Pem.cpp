@@ -2,6 +2,7 @@
 #include <cstring>
 #include <cstdio>
 #include <iostream>
+#include <vector>
 
 #include "mem/Pem.hpp"
 #include "med/MedCommon.hpp"
@@ -30,6 +31,15 @@ string Pem::bytesToString(Byte* buf, const string& scanType) {
   return memToString(buf, scanType);
 }
 
+string Pem::bytesToString(Byte* buf, size_t size, const string& scanType) {
+  if (scanType == SCAN_TYPE_STRING) {
+    vector<Byte> buffer(buf, buf + size);
+    buffer.push_back(0);
+    return bytesToString(buffer.data(), scanType);
+  }
+  return bytesToString(buf, scanType);
+}
+
 string Pem::getValue(const string& scanType) {
   MemPtr pem = memio->read(address, size);
   if (!pem) {
@@ -101,7 +111,11 @@ void Pem::setValue(const string& value, const string& scanType) {
 }
 
 void Pem::setScanType(const string& scanType) {
-  this->scanType = stringToScanType(scanType);
+  ScanType newScanType = stringToScanType(scanType);
+  if (newScanType == this->scanType && data) { // Filter calls this for every result
+    return;
+  }
+  this->scanType = newScanType;
   size_t newSize;
   Byte* newData;
   Byte* temp;
@@ -130,6 +144,11 @@ void Pem::rememberValue(const string& value, const string& scanType) {
 }
 
 void Pem::rememberValue(Byte* value, size_t size) {
+  // Reuse the buffer, so that filtering doesn't allocate for every result
+  if (!rememberedValue.isEmpty() && rememberedValue.getSize() == size) {
+    memcpy(rememberedValue.getBytes(), value, size);
+    return;
+  }
   rememberedValue = SizedBytes(value, size);
 }
 
@@ -137,7 +156,7 @@ string Pem::recallValue(const string& scanType) {
   if (rememberedValue.isEmpty()) {
     return "";
   }
-  return Pem::bytesToString(rememberedValue.getBytes(), scanType);
+  return Pem::bytesToString(rememberedValue.getBytes(), rememberedValue.getSize(), scanType);
 }
 
 Byte* Pem::recallValuePtr() {
@@ -0,0 +1,121 @@
+#include <algorithm>
+
+#include "mem/ReadPlanner.hpp"
+
+using namespace std;
+
+ReadPlanner::ReadPlanner(size_t maxGap) {
+  this->maxGap = maxGap;
+}
+
+void ReadPlanner::add(Address address, size_t size) {
+  requests.push_back(Request { address, size, 0, 0, false });
+}
+
+void ReadPlanner::clear() {
+  requests.clear();
+  ranges.clear();
+}
+
+size_t ReadPlanner::size() {
+  return requests.size();
+}
+
+void ReadPlanner::setMaxGap(size_t maxGap) {
+  this->maxGap = maxGap;
+}
+
+size_t ReadPlanner::getMaxGap() {
+  return maxGap;
+}
+
+void ReadPlanner::plan() {
+  ranges.clear();
+
+  vector<size_t> indices(requests.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    indices[i] = i;
+  }
+  bool sorted = std::is_sorted(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+      return a.address < b.address;
+    });
+  if (!sorted) {
+    std::stable_sort(indices.begin(), indices.end(), [this](size_t a, size_t b) {
+        return requests[a].address < requests[b].address;
+      });
+  }
+
+  for (size_t i = 0; i < indices.size(); i++) {
+    Request& request = requests[indices[i]];
+    Address end = request.address + request.size;
+
+    if (ranges.size()) {
+      MemRange& last = ranges.back();
+      Address lastEnd = last.address + last.size;
+      if (request.address <= lastEnd + maxGap &&
+          std::max(end, lastEnd) - last.address <= MAX_RANGE_SIZE) {
+        last.size = std::max(end, lastEnd) - last.address;
+        request.range = ranges.size() - 1;
+        request.offset = request.address - last.address;
+        continue;
+      }
+    }
+
+    ranges.push_back(MemRange { request.address, request.size, NULL, false });
+    request.range = ranges.size() - 1;
+    request.offset = 0;
+  }
+
+  buffer.resize(getBytesPlanned());
+  Byte* pointer = buffer.data();
+  for (auto& range : ranges) {
+    range.buffer = pointer;
+    pointer += range.size;
+  }
+}
+
+size_t ReadPlanner::read(MemIO* memio) {
+  plan();
+
+  memio->read(ranges, getBytesNeeded());
+
+  size_t numOfValid = 0;
+  for (auto& request : requests) {
+    request.valid = ranges[request.range].valid;
+    if (!request.valid && request.size < ranges[request.range].size) {
+      // The range crosses unreadable memory, but the value itself may be readable
+      Byte* data = ranges[request.range].buffer + request.offset;
+      request.valid = memio->read(request.address, data, request.size) == (ssize_t)request.size;
+    }
+    numOfValid += request.valid;
+  }
+  return numOfValid;
+}
+
+Byte* ReadPlanner::getData(size_t index) {
+  Request& request = requests[index];
+  if (!request.valid) {
+    return NULL;
+  }
+  return ranges[request.range].buffer + request.offset;
+}
+
+vector<MemRange>& ReadPlanner::getRanges() {
+  return ranges;
+}
+
+size_t ReadPlanner::getBytesNeeded() {
+  size_t bytes = 0;
+  for (auto& request : requests) {
+    bytes += request.size;
+  }
+  return bytes;
+}
+
+size_t ReadPlanner::getBytesPlanned() {
+  size_t bytes = 0;
+  for (auto& range : ranges) {
+    bytes += range.size;
+  }
+  return bytes;
+}
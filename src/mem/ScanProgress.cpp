@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "mem/ScanProgress.hpp"
+
+using namespace std;
+
+ScanProgress::ScanProgress() {
+  shared = false;
+  begin(0, 0);
+  matches = 0;
+  cancelled = false;
+  partialKept = 0;
+  finished = false;
+}
+
+void ScanProgress::begin(size_t bytes, size_t regions) {
+  if (shared) {
+    bytesTotal += bytes;
+    regionsTotal += regions;
+    return;
+  }
+  bytesTotal = bytes;
+  regionsTotal = regions;
+  bytesDone = 0;
+  regionsDone = 0;
+}
+
+void ScanProgress::setShared(bool shared) {
+  this->shared = shared;
+}
+
+void ScanProgress::addBytes(size_t bytes) {
+  bytesDone += bytes;
+}
+
+void ScanProgress::addRegion() {
+  regionsDone++;
+}
+
+size_t ScanProgress::getBytesDone() {
+  return bytesDone;
+}
+
+size_t ScanProgress::getBytesTotal() {
+  return bytesTotal;
+}
+
+size_t ScanProgress::getRegionsDone() {
+  return regionsDone;
+}
+
+size_t ScanProgress::getRegionsTotal() {
+  return regionsTotal;
+}
+
+double ScanProgress::getFraction() {
+  size_t total = bytesTotal;
+  if (total == 0) {
+    return isFinished() ? 1 : 0;
+  }
+  return std::min(1.0, (double)bytesDone / total);
+}
+
+void ScanProgress::cancel() {
+  cancelled = true;
+}
+
+bool ScanProgress::isCancelled() {
+  return cancelled;
+}
+
+void ScanProgress::addPartial(const vector<MemPtr>& found) {
+  matches += found.size();
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < found.size() && partialKept < MAX_PARTIAL_RESULTS; i++) {
+    partial.push_back(found[i]);
+    partialKept++;
+  }
+}
+
+vector<MemPtr> ScanProgress::takePartial() {
+  std::lock_guard<std::mutex> lock(mutex);
+  vector<MemPtr> taken;
+  taken.swap(partial);
+  return taken;
+}
+
+size_t ScanProgress::getMatches() {
+  return matches;
+}
+
+void ScanProgress::finish(const vector<MemPtr>& results, const string& error) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->results = results;
+    this->error = error;
+    finished = true;
+  }
+  cv.notify_all();
+}
+
+bool ScanProgress::isFinished() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return finished;
+}
+
+void ScanProgress::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [this] { return finished; });
+}
+
+vector<MemPtr> ScanProgress::getResults() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return results;
+}
+
+string ScanProgress::getError() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return error;
+}
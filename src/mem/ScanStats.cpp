@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "mem/ScanStats.hpp"
+
+using namespace std;
+
+namespace {
+  double toMs(int64_t ns) {
+    return ns / 1e6;
+  }
+}
+
+string ScanStats::toString() const {
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer),
+           "%s: %zu results in %.1f ms\n"
+           "  read %zu bytes, %zu syscalls, %zu pages read, %zu pages skipped\n"
+           "  read %.1f ms, compare %.1f ms, materialize %.1f ms, lock wait %.1f ms\n"
+           "  %zu tasks on %d threads, utilization %.0f%%",
+           operation.c_str(), results, wallTime,
+           bytesRead, syscalls, pagesRead, pagesSkipped,
+           readTime, compareTime, materializeTime, lockWaitTime,
+           tasks, threads, threadUtilization * 100);
+  return string(buffer);
+}
+
+string ScanStats::toSummary() const {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "%s %.1f ms: read %.1f, compare %.1f, materialize %.1f, lock wait %.1f (ms); %zu KB in %zu syscalls; %.0f%% utilization",
+           operation.c_str(), wallTime, readTime, compareTime, materializeTime, lockWaitTime,
+           bytesRead / 1024, syscalls, threadUtilization * 100);
+  return string(buffer);
+}
+
+ScanStatsRecorder::ScanStatsRecorder() {
+  stats = ScanStats();
+  begin("", 0);
+}
+
+int64_t ScanStatsRecorder::now() {
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ScanStatsRecorder::begin(const string& operation, int threads) {
+  this->operation = operation;
+  this->threads = threads;
+  beginTime = now();
+  bytesRead = 0;
+  syscalls = 0;
+  pagesRead = 0;
+  pagesSkipped = 0;
+  tasks = 0;
+  readTime = 0;
+  compareTime = 0;
+  materializeTime = 0;
+  lockWaitTime = 0;
+  taskTime = 0;
+}
+
+void ScanStatsRecorder::end(size_t results) {
+  int64_t wallTime = now() - beginTime;
+  int threads = std::max(this->threads, 1);
+
+  stats.operation = operation;
+  stats.bytesRead = bytesRead;
+  stats.syscalls = syscalls;
+  stats.pagesRead = pagesRead;
+  stats.pagesSkipped = pagesSkipped;
+  stats.results = results;
+  stats.tasks = tasks;
+  stats.threads = threads;
+  stats.wallTime = toMs(wallTime);
+  stats.readTime = toMs(readTime);
+  stats.compareTime = toMs(compareTime);
+  stats.materializeTime = toMs(materializeTime);
+  stats.lockWaitTime = toMs(lockWaitTime);
+  stats.threadUtilization = wallTime > 0 ? std::min(1.0, (double)taskTime / ((double)wallTime * threads)) : 0;
+}
+
+ScanStats ScanStatsRecorder::getStats() {
+  return stats;
+}
+
+void ScanStatsRecorder::addRead(size_t bytes, size_t syscalls, int64_t ns) {
+  bytesRead += bytes;
+  this->syscalls += syscalls;
+  readTime += ns;
+}
+
+void ScanStatsRecorder::addPages(size_t read, size_t skipped) {
+  pagesRead += read;
+  pagesSkipped += skipped;
+}
+
+void ScanStatsRecorder::addCompare(int64_t ns) {
+  compareTime += ns;
+}
+
+void ScanStatsRecorder::addMaterialize(int64_t ns) {
+  materializeTime += ns;
+}
+
+void ScanStatsRecorder::addLockWait(int64_t ns) {
+  lockWaitTime += ns;
+}
+
+void ScanStatsRecorder::addTask(int64_t ns) {
+  tasks++;
+  taskTime += ns;
+}
@@ -1,5 +1,6 @@
 #include <cstring>
 #include "mem/Sem.hpp"
+#include "med/MedException.hpp"
 
 Sem::Sem(PemPtr pem) : Pem(pem->getSize(), pem->getMemIO()) {
   memcpy(data, pem->getData(), size);
@@ -7,6 +8,8 @@ Sem::Sem(PemPtr pem) : Pem(pem->getSize(), pem->getMemIO()) {
   setScanType(pem->getScanType());
   locked = false;
   description = "No description";
+  lockInterval = LOCK_REFRESH_RATE;
+  corrections = 0;
 }
 
 Sem::Sem(Sem& sem) : Pem(sem.getSize(), sem.getMemIO()) {
@@ -15,14 +18,20 @@ Sem::Sem(Sem& sem) : Pem(sem.getSize(), sem.getMemIO()) {
   setScanType(sem.getScanType());
   locked = false;
   description = sem.getDescription();
+  lockInterval = sem.getLockInterval();
+  corrections = 0;
 }
 
 Sem::Sem(size_t size, MemIO* memio) : Pem(size, memio) {
   locked = false;
+  lockInterval = LOCK_REFRESH_RATE;
+  corrections = 0;
 }
 
 Sem::Sem(Address addr, size_t size, MemIO* memio) : Pem(addr, size, memio) {
   locked = false;
+  lockInterval = LOCK_REFRESH_RATE;
+  corrections = 0;
 }
 
 bool Sem::isLocked() {
@@ -32,6 +41,7 @@ bool Sem::isLocked() {
 void Sem::lock(bool value) {
   if (value) {
     setLockedValue(getValue(getScanType()));
+    corrections = 0;
   }
   locked = value;
 }
@@ -45,7 +55,26 @@ void Sem::setDescription(string s) {
 }
 
 void Sem::setLockedValue(string s) {
+  std::lock_guard<std::mutex> guard(lockMutex);
   lockedValue = s;
+  encodeLockedValue();
+}
+
+void Sem::encodeLockedValue() {
+  lockedScanType = getScanType();
+  try {
+    lockedBytes = Pem::stringToBytes(lockedValue, lockedScanType);
+  } catch (MedException &ex) {
+    lockedBytes = SizedBytes();
+  }
+}
+
+SizedBytes Sem::getLockedBytes() {
+  std::lock_guard<std::mutex> guard(lockMutex);
+  if (lockedScanType != getScanType()) {
+    encodeLockedValue();
+  }
+  return lockedBytes;
 }
 
 string& Sem::getLockedValue() {
@@ -53,7 +82,28 @@ string& Sem::getLockedValue() {
 }
 
 void Sem::lockValue() {
-  setValue(getLockedValue(), getScanType());
+  SizedBytes bytes = getLockedBytes();
+  if (bytes.isEmpty()) {
+    return;
+  }
+  vector<MemRange> ranges { MemRange { address, bytes.getSize(), bytes.getBytes(), false } };
+  getMemIO()->write(ranges);
+}
+
+int Sem::getLockInterval() {
+  return lockInterval;
+}
+
+void Sem::setLockInterval(int ms) {
+  lockInterval = ms < 1 ? 1 : ms;
+}
+
+size_t Sem::getCorrections() {
+  return corrections;
+}
+
+void Sem::addCorrection() {
+  corrections++;
 }
 
 SemPtr Sem::clone(SemPtr semPtr) {
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "mem/Pem.hpp"
+#include "mem/ReadPlanner.hpp"
+#include "mem/StringUtil.hpp"
+#include "mem/StructTemplate.hpp"
+
+using namespace std;
+
+namespace {
+  vector<string> tokenize(const string& line) {
+    vector<string> tokens;
+    for (auto& token : StringUtil::split(line, ' ')) {
+      string trimmed = StringUtil::trim(token);
+      if (trimmed.length() > 0) {
+        tokens.push_back(trimmed);
+      }
+    }
+    return tokens;
+  }
+
+  string lineError(int lineNumber, const string& message) {
+    return string("Struct template line ") + to_string(lineNumber) + ": " + message;
+  }
+}
+
+StructTemplate::StructTemplate() {}
+
+StructTemplate::StructTemplate(const string& definition) {
+  compile(definition);
+}
+
+void StructTemplate::compile(const string& definition) {
+  fields.clear();
+  stages.clear();
+
+  vector<int> parents; // Pointer fields of the open braces
+  vector<string> lines = StringUtil::split(definition, '\n');
+  for (size_t i = 0; i < lines.size(); i++) {
+    string line = lines[i];
+    size_t comment = line.find('#');
+    if (comment != string::npos) {
+      line = line.substr(0, comment);
+    }
+    std::replace(line.begin(), line.end(), '\t', ' ');
+    line = StringUtil::trim(line);
+    if (line.length() == 0) {
+      continue;
+    }
+    addField(line, i + 1, parents);
+  }
+
+  if (parents.size() > 0) {
+    string name = fields[parents.back()].name;
+    fields.clear();
+    throw MedException("Struct template: missing \"}\" of " + name);
+  }
+  plan();
+}
+
+void StructTemplate::addField(const string& line, int lineNumber, vector<int>& parents) {
+  vector<string> tokens = tokenize(line);
+  if (tokens.size() == 1 && tokens[0] == "}") {
+    if (parents.size() == 0) {
+      throw MedException(lineError(lineNumber, "unexpected \"}\""));
+    }
+    parents.pop_back();
+    return;
+  }
+
+  bool opening = tokens.size() == 4 && tokens[3] == "{";
+  if (tokens.size() != 3 && !opening) {
+    throw MedException(lineError(lineNumber, "expected \"name offset type\""));
+  }
+
+  string name = tokens[0];
+  size_t offset;
+  try {
+    offset = hexToInt(tokens[1]);
+  } catch (const MedException& ex) {
+    throw MedException(lineError(lineNumber, "invalid offset " + tokens[1]));
+  }
+
+  string type = tokens[2];
+  size_t count = 0;
+  size_t bracket = type.find('[');
+  if (bracket != string::npos) {
+    if (type.back() != ']') {
+      throw MedException(lineError(lineNumber, "invalid array " + type));
+    }
+    try {
+      count = stoul(type.substr(bracket + 1, type.length() - bracket - 2));
+    } catch (const std::exception& ex) {
+      throw MedException(lineError(lineNumber, "invalid array " + type));
+    }
+    if (count == 0 || count > MAX_ARRAY_SIZE) {
+      throw MedException(lineError(lineNumber, "invalid array size " + type));
+    }
+    type = type.substr(0, bracket);
+  }
+
+  ScanType scanType = stringToScanType(type);
+  if (scanType == Unknown || scanType == Custom) {
+    throw MedException(lineError(lineNumber, "invalid type " + type));
+  }
+  if (scanType == String && count == 0) {
+    throw MedException(lineError(lineNumber, "string needs a size, such as string[16]"));
+  }
+  if (opening && ((scanType != Ptr32 && scanType != Ptr64) || count > 0)) {
+    throw MedException(lineError(lineNumber, "only a pointer can have nested fields"));
+  }
+
+  int base = parents.size() > 0 ? parents.back() : -1;
+  string prefix = base >= 0 ? fields[base].name + "." : "";
+
+  if (scanType == String) {
+    fields.push_back(StructField { prefix + name, base, offset, count, type });
+  }
+  else if (count > 0) {
+    size_t size = scanTypeToSize(scanType);
+    for (size_t i = 0; i < count; i++) {
+      string element = prefix + name + "[" + to_string(i) + "]";
+      fields.push_back(StructField { element, base, offset + i * size, size, type });
+    }
+  }
+  else {
+    fields.push_back(StructField { prefix + name, base, offset, (size_t)scanTypeToSize(scanType), type });
+  }
+
+  if (opening) {
+    parents.push_back(fields.size() - 1);
+  }
+}
+
+/**
+ * Group the fields by their base into blocks spanning all of them,
+ * and the blocks by the depth, because a nested block needs the pointer read by the previous depth.
+ */
+void StructTemplate::plan() {
+  vector<size_t> depths(fields.size(), 0);
+  map<int, Block> blocks;
+  for (size_t i = 0; i < fields.size(); i++) {
+    auto& field = fields[i];
+    if (field.base >= 0) {
+      depths[i] = depths[field.base] + 1;
+    }
+
+    auto it = blocks.find(field.base);
+    if (it == blocks.end()) {
+      blocks[field.base] = Block { field.base, field.offset, field.size, { i } };
+      continue;
+    }
+    Block& block = it->second;
+    size_t end = std::max(block.offset + block.size, field.offset + field.size);
+    block.offset = std::min(block.offset, field.offset);
+    block.size = end - block.offset;
+    block.fields.push_back(i);
+  }
+
+  for (auto& pair : blocks) {
+    size_t depth = pair.first >= 0 ? depths[pair.first] + 1 : 0;
+    if (stages.size() <= depth) {
+      stages.resize(depth + 1);
+    }
+    stages[depth].push_back(pair.second);
+  }
+}
+
+const vector<StructField>& StructTemplate::getFields() {
+  return fields;
+}
+
+vector<string> StructTemplate::getFieldNames() {
+  vector<string> names;
+  for (auto& field : fields) {
+    names.push_back(field.name);
+  }
+  return names;
+}
+
+size_t StructTemplate::getNumOfFields() {
+  return fields.size();
+}
+
+vector<vector<string>> StructTemplate::read(MemIO* memio, const vector<Address>& addresses) {
+  size_t numOfFields = fields.size();
+  vector<vector<string>> values(addresses.size(), vector<string>(numOfFields));
+  vector<Address> pointers(addresses.size() * numOfFields, 0); // Values of the pointer fields
+
+  for (auto& stage : stages) {
+    ReadPlanner planner;
+    vector<pair<size_t, const Block*>> planned; // Instance and block, by the order of the planner
+    for (auto& block : stage) {
+      for (size_t i = 0; i < addresses.size(); i++) {
+        Address base = block.base < 0 ? addresses[i] : pointers[i * numOfFields + block.base];
+        if (!base) {
+          continue;
+        }
+        planner.add(base + block.offset, block.size);
+        planned.push_back(make_pair(i, &block));
+      }
+    }
+    planner.read(memio);
+
+    for (size_t k = 0; k < planned.size(); k++) {
+      Byte* data = planner.getData(k);
+      if (!data) {
+        continue;
+      }
+      size_t instance = planned[k].first;
+      const Block* block = planned[k].second;
+      for (auto index : block->fields) {
+        auto& field = fields[index];
+        Byte* value = data + field.offset - block->offset;
+        try {
+          values[instance][index] = Pem::bytesToString(value, field.size, field.scanType);
+        } catch (const MedException& ex) {}
+
+        if (field.scanType == SCAN_TYPE_PTR_64) {
+          uint64_t pointer;
+          memcpy(&pointer, value, sizeof(pointer));
+          pointers[instance * numOfFields + index] = pointer;
+        }
+        else if (field.scanType == SCAN_TYPE_PTR_32) {
+          uint32_t pointer;
+          memcpy(&pointer, value, sizeof(pointer));
+          pointers[instance * numOfFields + index] = pointer;
+        }
+      }
+    }
+  }
+  return values;
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "mem/ReadPlanner.hpp"
+#include "mem/TypeAnalyzer.hpp"
+
+using namespace std;
+
+namespace {
+  const double MIN_SANE_FLOAT = 1e-4;
+  const double MAX_SANE_FLOAT = 1e7;
+  const double MIN_SANE_DOUBLE = 1e-6;
+  const double MAX_SANE_DOUBLE = 1e12;
+  const int32_t MAX_SANE_INT = 1000000;
+  const int MIN_STRING_LENGTH = 4;
+  const double CHURN_BITS = 8; // A counter flips fewer bits on average between the samples
+
+  bool isSane(double value, double low, double high) {
+    double magnitude = std::fabs(value);
+    return std::isfinite(value) && magnitude >= low && magnitude <= high;
+  }
+
+  bool isPrintable(uint64_t value) {
+    Byte bytes[TypeAnalyzer::SAMPLE_SIZE];
+    memcpy(bytes, &value, sizeof(bytes));
+    for (int i = 0; i < (int)sizeof(bytes); i++) {
+      if (bytes[i] == 0) {
+        return i >= MIN_STRING_LENGTH;
+      }
+      if (bytes[i] < 0x20 || bytes[i] > 0x7e) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  double fraction(size_t count, size_t total) {
+    return total ? (double)count / total : 0;
+  }
+}
+
+TypeAnalyzer::TypeAnalyzer(MemIO* memio) {
+  this->memio = memio;
+  numOfSamples = 0;
+}
+
+void TypeAnalyzer::setMaps(const Maps& maps) {
+  this->maps = maps;
+  this->maps.sort();
+}
+
+void TypeAnalyzer::setAddresses(const vector<Address>& addresses) {
+  this->addresses = addresses;
+  samples.assign(addresses.size(), vector<uint64_t>());
+  numOfSamples = 0;
+}
+
+const vector<Address>& TypeAnalyzer::getAddresses() {
+  return addresses;
+}
+
+void TypeAnalyzer::sample() {
+  ReadPlanner planner;
+  for (auto address : addresses) {
+    planner.add(address, SAMPLE_SIZE);
+  }
+  planner.read(memio);
+
+  for (size_t i = 0; i < addresses.size(); i++) {
+    Byte* data = planner.getData(i);
+    if (data) {
+      uint64_t value;
+      memcpy(&value, data, sizeof(value));
+      samples[i].push_back(value);
+    }
+  }
+  numOfSamples++;
+}
+
+size_t TypeAnalyzer::getNumOfSamples() {
+  return numOfSamples;
+}
+
+vector<TypeGuess> TypeAnalyzer::classify() {
+  vector<TypeGuess> guesses;
+  guesses.reserve(addresses.size());
+  for (auto& values : samples) {
+    guesses.push_back(classify(values, maps));
+  }
+  return guesses;
+}
+
+/**
+ * Each kind is scored by the ratio of the plausible samples, where the zero samples tell nothing.
+ * Then the change pattern adjusts the scores: a float keeps its exponent while its mantissa churns,
+ * but a counter flips few bits. The ties are broken by the order of the candidates.
+ */
+TypeGuess TypeAnalyzer::classify(const vector<uint64_t>& samples, Maps& maps) {
+  size_t nonZero32 = 0, nonZero64 = 0;
+  size_t ints = 0, floats = 0, doubles = 0, pointers = 0, strings = 0, bools = 0;
+  bool seenFalse = false, seenTrue = false;
+  bool exponentStable = true;
+  bool changed = false;
+  double churn = 0;
+  int32_t maxDelta = 0;
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    uint64_t value = samples[i];
+    uint32_t low = (uint32_t)value;
+    float asFloat;
+    double asDouble;
+    memcpy(&asFloat, &low, sizeof(asFloat));
+    memcpy(&asDouble, &value, sizeof(asDouble));
+
+    strings += isPrintable(value);
+    bools += low <= 1;
+    seenFalse |= low == 0;
+    seenTrue |= low == 1;
+    if (low != 0) {
+      nonZero32++;
+      ints += std::abs((int64_t)(int32_t)low) <= MAX_SANE_INT;
+      floats += isSane(asFloat, MIN_SANE_FLOAT, MAX_SANE_FLOAT);
+    }
+    if (value != 0) {
+      nonZero64++;
+      doubles += isSane(asDouble, MIN_SANE_DOUBLE, MAX_SANE_DOUBLE);
+      pointers += value % 4 == 0 && maps.contains(value);
+    }
+
+    if (i > 0) {
+      uint32_t previous = (uint32_t)samples[i - 1];
+      changed |= low != previous;
+      churn += __builtin_popcount(low ^ previous);
+      maxDelta = std::max(maxDelta, (int32_t)std::min<int64_t>(std::abs((int64_t)(int32_t)low - (int32_t)previous), INT32_MAX));
+      if (low != 0 && previous != 0) {
+        exponentStable &= (low >> 23) == (previous >> 23);
+      }
+    }
+  }
+
+  if (samples.size() == 0) {
+    return TypeGuess { "unknown", SCAN_TYPE_INT_32, 0 };
+  }
+  if (nonZero64 == 0) { // Zero is any type
+    return TypeGuess { "unknown", SCAN_TYPE_INT_32, 0 };
+  }
+  churn /= std::max(samples.size() - 1, (size_t)1);
+
+  double intScore = fraction(ints, nonZero32);
+  double floatScore = fraction(floats, nonZero32);
+  if (changed) {
+    intScore += churn < CHURN_BITS && maxDelta <= MAX_SANE_INT ? 0.1 : -0.2;
+    floatScore += exponentStable ? 0.1 : 0;
+  }
+
+  vector<TypeGuess> candidates = {
+    { "pointer", SCAN_TYPE_PTR_64, fraction(pointers, nonZero64) },
+    { "string", SCAN_TYPE_STRING, fraction(strings, samples.size()) * 0.9 },
+    { "bool", SCAN_TYPE_INT_8, seenFalse && seenTrue ? fraction(bools, samples.size()) : 0 },
+    { "int", SCAN_TYPE_INT_32, intScore },
+    { "float", SCAN_TYPE_FLOAT_32, floatScore },
+    { "double", SCAN_TYPE_FLOAT_64, fraction(doubles, nonZero64) }
+  };
+
+  TypeGuess best = { "unknown", SCAN_TYPE_INT_32, 0 };
+  for (auto& candidate : candidates) {
+    candidate.confidence = std::min(std::max(candidate.confidence, 0.0), 1.0);
+    if (candidate.confidence > best.confidence) {
+      best = candidate;
+    }
+  }
+  return best;
+}
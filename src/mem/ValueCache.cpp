@@ -0,0 +1,138 @@
+#include <chrono>
+
+#include "med/MedException.hpp"
+#include "mem/Pem.hpp"
+#include "mem/ReadPlanner.hpp"
+#include "mem/ValueCache.hpp"
+
+using namespace std;
+
+namespace {
+  const int DEFAULT_VALUE_CACHE_INTERVAL = 800; // ms
+}
+
+ValueCache::ValueCache(MemIO* memio) {
+  this->memio = memio;
+  interval = DEFAULT_VALUE_CACHE_INTERVAL;
+  thread = NULL;
+  running = false;
+  pending = false;
+}
+
+ValueCache::~ValueCache() {
+  stop();
+}
+
+void ValueCache::setRequests(const string& name, const vector<ValueRequest>& requests) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->requests[name] = requests;
+}
+
+vector<CachedValue> ValueCache::getValues(const string& name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = front.find(name);
+  return it == front.end() ? vector<CachedValue>() : it->second;
+}
+
+void ValueCache::setCallback(std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock(mutex);
+  this->callback = callback;
+}
+
+void ValueCache::setInterval(int ms) {
+  std::lock_guard<std::mutex> lock(mutex);
+  interval = std::max(ms, 1);
+}
+
+void ValueCache::start() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    return;
+  }
+  running = true;
+  thread = new std::thread(&ValueCache::run, this);
+}
+
+void ValueCache::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      return;
+    }
+    running = false;
+  }
+  cv.notify_all();
+  thread->join();
+  delete thread;
+  thread = NULL;
+}
+
+void ValueCache::refresh() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending = true;
+  }
+  cv.notify_all();
+}
+
+void ValueCache::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    pending = false;
+    lock.unlock();
+    update();
+    lock.lock();
+    cv.wait_for(lock, chrono::milliseconds(interval), [this] { return !running || pending; });
+  }
+}
+
+void ValueCache::update() {
+  std::lock_guard<std::mutex> updateLock(updateMutex);
+  map<string, vector<ValueRequest>> requests;
+  std::function<void()> callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    requests = this->requests;
+    callback = this->callback;
+  }
+
+  map<string, vector<CachedValue>> back;
+  for (auto& pair : requests) {
+    auto& group = pair.second;
+    auto& values = back[pair.first];
+    values.resize(group.size());
+
+    // Each process is read in its own batch
+    map<MemIO*, vector<size_t>> indicesByMemIO;
+    for (size_t i = 0; i < group.size(); i++) {
+      indicesByMemIO[group[i].memio ? group[i].memio : memio].push_back(i);
+    }
+    for (auto& indices : indicesByMemIO) {
+      ReadPlanner planner;
+      for (auto i : indices.second) {
+        planner.add(group[i].address, group[i].size);
+      }
+      planner.read(indices.first);
+
+      for (size_t j = 0; j < indices.second.size(); j++) {
+        size_t i = indices.second[j];
+        string value;
+        Byte* data = planner.getData(j);
+        if (data) {
+          try {
+            value = Pem::bytesToString(data, group[i].size, group[i].scanType);
+          } catch (const MedException& ex) {}
+        }
+        values[i] = CachedValue { group[i].row, group[i].address, value };
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    front.swap(back);
+  }
+  if (callback) {
+    callback();
+  }
+}
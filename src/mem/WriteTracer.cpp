@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/ptrace.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+#include "mem/WriteTracer.hpp"
+
+using namespace std;
+
+namespace {
+  const int WAKE_SIGNAL = SIGUSR2;
+
+  void onWake(int) {}
+
+  void installWakeHandler(struct sigaction* previous) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onWake;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0; // No SA_RESTART, so that waitpid() returns EINTR
+    sigaction(WAKE_SIGNAL, &action, previous);
+  }
+
+  vector<pid_t> listThreads(pid_t pid) {
+    vector<pid_t> tids;
+    string path = "/proc/" + to_string(pid) + "/task";
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+      return tids;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] != '.') {
+        tids.push_back(atoi(entry->d_name));
+      }
+    }
+    closedir(dir);
+    return tids;
+  }
+
+  bool isGroupStop(int status) {
+    int sig = WSTOPSIG(status);
+    return (status >> 16) == PTRACE_EVENT_STOP &&
+      (sig == SIGSTOP || sig == SIGTSTP || sig == SIGTTIN || sig == SIGTTOU);
+  }
+
+#if defined(__x86_64__)
+  long debugRegOffset(int index) {
+    return offsetof(struct user, u_debugreg) + index * sizeof(((struct user*)0)->u_debugreg[0]);
+  }
+
+  // DR7: local enable of DR0, break on data writes, and the length
+  unsigned long dr7Value(size_t size) {
+    unsigned long len = size == 1 ? 0 : size == 2 ? 1 : size == 8 ? 2 : 3;
+    return 1UL | (1UL << 16) | (len << 18);
+  }
+
+  bool arm(pid_t tid, Address address, size_t size) {
+    return ptrace(PTRACE_POKEUSER, tid, debugRegOffset(0), address) != -1 &&
+      ptrace(PTRACE_POKEUSER, tid, debugRegOffset(7), dr7Value(size)) != -1;
+  }
+
+  void disarm(pid_t tid) {
+    ptrace(PTRACE_POKEUSER, tid, debugRegOffset(7), 0);
+  }
+
+  /**
+   * Check and clear DR6, so that the next trap is not mistaken.
+   * @return true if the trap is triggered by DR0
+   */
+  bool takeWatchpointHit(pid_t tid, Address& ip) {
+    errno = 0;
+    long dr6 = ptrace(PTRACE_PEEKUSER, tid, debugRegOffset(6), 0);
+    if (errno != 0 || !(dr6 & 1)) {
+      return false;
+    }
+    ptrace(PTRACE_POKEUSER, tid, debugRegOffset(6), 0);
+
+    struct user_regs_struct regs;
+    if (ptrace(PTRACE_GETREGS, tid, 0, &regs) == -1) {
+      return false;
+    }
+    ip = regs.rip;
+    return true;
+  }
+#else
+  bool arm(pid_t, Address, size_t) { return false; }
+  void disarm(pid_t) {}
+  bool takeWatchpointHit(pid_t, Address&) { return false; }
+#endif
+}
+
+WriteTracer::WriteTracer(pid_t pid) {
+  this->pid = pid;
+  thread = NULL;
+  running = false;
+  stopping = false;
+  ready = false;
+}
+
+WriteTracer::~WriteTracer() {
+  stop();
+}
+
+bool WriteTracer::isSupported() {
+#if defined(__x86_64__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void WriteTracer::start(Address address, size_t size) {
+  if (!isSupported()) {
+    throw MedException("Write tracer requires x86_64 debug registers");
+  }
+  if (size != 1 && size != 2 && size != 4 && size != 8) {
+    throw MedException("Write tracer size must be 1, 2, 4 or 8");
+  }
+  if (address % size != 0) {
+    throw MedException("Write tracer address must be aligned to the size");
+  }
+  stop();
+
+  installWakeHandler(&previousWakeAction);
+  ready = false;
+  error = "";
+  stopping = false;
+  running = true;
+  thread = new std::thread(&WriteTracer::run, this, address, size);
+
+  std::unique_lock<std::mutex> lock(readyMutex);
+  readyCv.wait(lock, [this] { return ready; });
+  if (error != "") {
+    lock.unlock();
+    thread->join();
+    delete thread;
+    thread = NULL;
+    sigaction(WAKE_SIGNAL, &previousWakeAction, NULL);
+    throw MedException(error);
+  }
+}
+
+void WriteTracer::stop() {
+  if (!thread) {
+    return;
+  }
+  stopping = true;
+
+  // Repeat the signal, in case it arrives before the event loop enters waitpid()
+  std::unique_lock<std::mutex> lock(readyMutex);
+  while (running) {
+    pthread_kill(thread->native_handle(), WAKE_SIGNAL);
+    readyCv.wait_for(lock, chrono::milliseconds(10), [this] { return !running; });
+  }
+  lock.unlock();
+
+  thread->join();
+  delete thread;
+  thread = NULL;
+  sigaction(WAKE_SIGNAL, &previousWakeAction, NULL);
+}
+
+bool WriteTracer::isRunning() {
+  return running;
+}
+
+vector<WriteHit> WriteTracer::getHits() {
+  unordered_map<Address, size_t> counts;
+  {
+    std::lock_guard<std::mutex> lock(hitsMutex);
+    counts = hits;
+  }
+
+  vector<Module> modules;
+  try {
+    modules = getModules(pid);
+  } catch (MedException& e) {
+    // Process is gone, report the addresses only
+  }
+
+  vector<WriteHit> result;
+  for (auto& pair : counts) {
+    result.push_back(WriteHit { pair.first, pair.second, addressToModuleOffset(modules, pair.first) });
+  }
+  sort(result.begin(), result.end(), [](const WriteHit& a, const WriteHit& b) {
+      return a.count != b.count ? a.count > b.count : a.ip < b.ip;
+    });
+  return result;
+}
+
+void WriteTracer::clearHits() {
+  std::lock_guard<std::mutex> lock(hitsMutex);
+  hits.clear();
+}
+
+void WriteTracer::notifyReady(const string& error) {
+  {
+    std::lock_guard<std::mutex> lock(readyMutex);
+    this->error = error;
+    ready = true;
+  }
+  readyCv.notify_all();
+}
+
+void WriteTracer::run(Address address, size_t size) {
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, WAKE_SIGNAL);
+  pthread_sigmask(SIG_UNBLOCK, &mask, NULL);
+
+  try {
+    attachAll(address, size);
+    notifyReady("");
+    loop(address, size);
+  } catch (MedException& e) {
+    notifyReady(e.getMessage());
+  }
+  detachAll();
+
+  {
+    std::lock_guard<std::mutex> lock(readyMutex);
+    running = false;
+  }
+  readyCv.notify_all();
+}
+
+void WriteTracer::attachAll(Address address, size_t size) {
+  // Threads may be created while attaching, list again until nothing new.
+  // Threads created by the attached threads are attached by PTRACE_O_TRACECLONE, and armed in the loop.
+  set<pid_t> tried;
+  bool found = true;
+  while (found) {
+    found = false;
+    for (pid_t tid : listThreads(pid)) {
+      if (tried.count(tid)) {
+        continue;
+      }
+      tried.insert(tid);
+      found = true;
+      try {
+        attachThread(tid, address, size);
+      } catch (MedException& e) {
+        if (tid == pid) {
+          throw;
+        }
+      }
+    }
+  }
+  if (threads.empty()) {
+    throw MedException("Failed attach " + to_string(pid));
+  }
+}
+
+void WriteTracer::attachThread(pid_t tid, Address address, size_t size) {
+  if (ptrace(PTRACE_SEIZE, tid, 0, PTRACE_O_TRACECLONE) == -1) {
+    throw MedException("Failed attach " + to_string(tid) + ": " + strerror(errno));
+  }
+  threads.insert(tid);
+
+  int status;
+  ptrace(PTRACE_INTERRUPT, tid, 0, 0);
+  if (waitpid(tid, &status, __WALL) == -1 || !WIFSTOPPED(status)) {
+    threads.erase(tid);
+    throw MedException("Failed stop " + to_string(tid));
+  }
+  if (!arm(tid, address, size)) {
+    string reason = strerror(errno);
+    ptrace(PTRACE_DETACH, tid, 0, 0);
+    threads.erase(tid);
+    throw MedException("Failed set debug registers: " + reason);
+  }
+
+  // The stop may be a signal, rather than the interrupt, which is then reported by the loop
+  int sig = (status >> 16) == 0 ? WSTOPSIG(status) : 0;
+  ptrace(PTRACE_CONT, tid, 0, sig);
+}
+
+pid_t WriteTracer::waitTracee(int& status, bool block) {
+  while (true) {
+    // Peek without consuming, the statuses of the other children of med are left for their owners
+    siginfo_t info;
+    info.si_pid = 0;
+    if (waitid(P_ALL, 0, &info, WEXITED | WSTOPPED | WNOWAIT | __WALL | (block ? 0 : WNOHANG)) == -1) {
+      return -1;
+    }
+    if (info.si_pid == 0) {
+      return 0;
+    }
+    if (isTracee(info.si_pid)) {
+      return waitpid(info.si_pid, &status, __WALL);
+    }
+
+    // Another child is waitable and keeps being peeked, so poll the tracees one by one
+    for (auto tracees : { &threads, &clones }) {
+      for (pid_t tid : *tracees) {
+        pid_t waited = waitpid(tid, &status, __WALL | WNOHANG);
+        if (waited > 0) {
+          return waited;
+        }
+      }
+    }
+    if (!block) {
+      return 0;
+    }
+    struct timespec interval = { 0, 1000000 };
+    if (nanosleep(&interval, NULL) == -1) {
+      return -1; // EINTR by stop()
+    }
+  }
+}
+
+bool WriteTracer::isTracee(pid_t tid) {
+  return threads.count(tid) || clones.count(tid);
+}
+
+void WriteTracer::loop(Address address, size_t size) {
+  while (!stopping) {
+    int status;
+    pid_t tid = waitTracee(status, true);
+    if (tid == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break; // No more tracee
+    }
+
+    if (WIFEXITED(status) || WIFSIGNALED(status)) {
+      threads.erase(tid);
+      clones.erase(tid);
+      if (threads.empty()) {
+        break;
+      }
+      continue;
+    }
+    if (!WIFSTOPPED(status)) {
+      continue;
+    }
+
+    // New thread by clone
+    if (!threads.count(tid)) {
+      clones.erase(tid);
+      threads.insert(tid);
+      arm(tid, address, size);
+      ptrace(PTRACE_CONT, tid, 0, 0);
+      continue;
+    }
+
+    int event = status >> 16;
+    if (isGroupStop(status)) {
+      ptrace(PTRACE_LISTEN, tid, 0, 0); // Keep the process stopped, such as suspended by the user
+      continue;
+    }
+    if (event == PTRACE_EVENT_CLONE) {
+      addClone(tid);
+    }
+    if (event != 0) {
+      ptrace(PTRACE_CONT, tid, 0, 0);
+      continue;
+    }
+
+    int sig = WSTOPSIG(status);
+    Address ip;
+    if (sig == SIGTRAP && takeWatchpointHit(tid, ip)) {
+      {
+        std::lock_guard<std::mutex> lock(hitsMutex);
+        hits[ip]++;
+      }
+      sig = 0;
+    }
+    ptrace(PTRACE_CONT, tid, 0, sig);
+  }
+}
+
+void WriteTracer::detachAll() {
+  for (pid_t tid : threads) {
+    ptrace(PTRACE_INTERRUPT, tid, 0, 0);
+    int status;
+    if (waitpid(tid, &status, __WALL) == -1 || !WIFSTOPPED(status)) {
+      continue;
+    }
+
+    // Pass the pending signal, but not the trap of the watchpoint
+    int sig = 0;
+    Address ip;
+    if ((status >> 16) == PTRACE_EVENT_CLONE) {
+      addClone(tid);
+    }
+    if ((status >> 16) == 0) {
+      sig = WSTOPSIG(status);
+      if (sig == SIGTRAP && takeWatchpointHit(tid, ip)) {
+        std::lock_guard<std::mutex> lock(hitsMutex);
+        hits[ip]++;
+        sig = 0;
+      }
+    }
+    disarm(tid);
+    ptrace(PTRACE_DETACH, tid, 0, sig);
+  }
+  threads.clear();
+
+  // Threads cloned but not yet stopped, they are never armed.
+  // They are traced since the clone, so their first stop will be reported.
+  for (pid_t tid : clones) {
+    int status;
+    if (waitpid(tid, &status, __WALL) != -1 && WIFSTOPPED(status)) {
+      ptrace(PTRACE_DETACH, tid, 0, 0);
+    }
+  }
+  clones.clear();
+}
+
+void WriteTracer::addClone(pid_t tid) {
+  unsigned long newTid;
+  if (ptrace(PTRACE_GETEVENTMSG, tid, 0, &newTid) != -1 && !threads.count((pid_t)newTid)) {
+    clones.insert((pid_t)newTid);
+  }
+}
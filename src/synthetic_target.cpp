@@ -0,0 +1,391 @@
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <json/json.h>
+
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+/**
+ * Deterministic target process for benchmarks and correctness tests.
+ *
+ * Allocates the heap across several mappings, each its own VMA between the guard pages, then plants
+ * the known values, structs, pointer chains and strings at the locations chosen by the seed. The same seed produces the same layout
+ * relative to each mapping. The ground truth (absolute addresses) is written as JSON after the setup,
+ * to a file (written to a temporary file, then renamed, so that the reader never sees a partial file)
+ * or to stdout with "--truth=-", so that the parent can read it from a pipe.
+ *
+ * Then, on every interval, the counters are incremented by their step, the tick is incremented,
+ * and the noise pages are overwritten. Value of a counter is "value + step * tick".
+ *
+ * Usage: synthetic_target [--size_mb=256] [--mappings=4] [--seed=1] [--fill=random|zero]
+ *                         [--values=1000] [--value=100] [--structs=100] [--chains=10] [--depth=4]
+ *                         [--strings=100] [--counters=10] [--noise_pages=16] [--interval=100]
+ *                         [--truth=-]
+ */
+
+namespace {
+  const size_t CELL_SIZE = 64; // Each planted item takes a cell, so that items never overlap
+
+  struct Options {
+    size_t size = 256 * 1024 * 1024;
+    size_t mappings = 4;
+    uint64_t seed = 1;
+    string fill = "random";
+    size_t values = 1000;
+    int32_t value = 100;
+    size_t structs = 100;
+    size_t chains = 10;
+    size_t depth = 4;
+    size_t strings = 100;
+    size_t counters = 10;
+    size_t noisePages = 16;
+    int interval = 100;
+    string truth = "-";
+  };
+
+  struct PlantedStruct {
+    int32_t health;
+    float speed;
+    int16_t level;
+    int8_t flag;
+    int8_t padding;
+    int64_t gold;
+    double x;
+  };
+
+  struct Counter {
+    int32_t* address;
+    int32_t step;
+  };
+
+  // Bases of the pointer chains, static so that the chains can be resolved as module+offset
+  Address chainBases[1024];
+  volatile int64_t tick = 0;
+
+  class Random {
+  public:
+    explicit Random(uint64_t seed) : state(seed ? seed : 88172645463325252ULL) {}
+
+    uint64_t next() {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return state;
+    }
+
+    uint64_t below(uint64_t n) {
+      return next() % n;
+    }
+
+  private:
+    uint64_t state;
+  };
+
+  class Heap {
+  public:
+    Heap(const Options& options, Random& random) : random(random) {
+      size_t pageSize = getpagesize();
+      size_t mappingSize = std::max(options.size / options.mappings / pageSize, (size_t)1) * pageSize;
+
+      // Adjacent anonymous mappings are merged into one VMA by the kernel, so reserve them together,
+      // with a PROT_NONE guard page before, between and after them.
+      size_t reserved = options.mappings * (mappingSize + pageSize) + pageSize;
+      Byte* base = (Byte*)mmap(NULL, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (base == MAP_FAILED) {
+        throw MedException("Failed reserve the mappings");
+      }
+      for (size_t i = 0; i < options.mappings; i++) {
+        Byte* start = base + pageSize + i * (mappingSize + pageSize);
+        if (mprotect(start, mappingSize, PROT_READ | PROT_WRITE) == -1) {
+          throw MedException("Failed allocate the mapping " + to_string(i));
+        }
+        fill(start, mappingSize, options.fill);
+        mappings.push_back(AddressPair((Address)start, (Address)start + mappingSize));
+      }
+      cellsPerMapping = mappingSize / CELL_SIZE;
+    }
+
+    /**
+     * Take an unused cell from a random mapping
+     */
+    Byte* takeCell() {
+      if (used.size() >= cellsPerMapping * mappings.size()) {
+        throw MedException("Heap is too small for the planted items");
+      }
+      size_t index;
+      do {
+        index = random.below(cellsPerMapping * mappings.size());
+      } while (used.count(index));
+      used.insert(index);
+
+      auto& mapping = mappings[index / cellsPerMapping];
+      return (Byte*)(mapping.first + (index % cellsPerMapping) * CELL_SIZE);
+    }
+
+    /**
+     * Take a page of unused cells, the whole page is overwritten by the noise
+     */
+    Byte* takePage() {
+      size_t cellsPerPage = getpagesize() / CELL_SIZE;
+      size_t pages = cellsPerMapping / cellsPerPage * mappings.size();
+      for (size_t attempt = 0; attempt < pages * 2; attempt++) {
+        size_t page = random.below(pages);
+        size_t first = page * cellsPerPage;
+        bool free = true;
+        for (size_t i = first; i < first + cellsPerPage && free; i++) {
+          free = !used.count(i);
+        }
+        if (!free) {
+          continue;
+        }
+        for (size_t i = first; i < first + cellsPerPage; i++) {
+          used.insert(i);
+        }
+        auto& mapping = mappings[first / cellsPerMapping];
+        return (Byte*)(mapping.first + (first % cellsPerMapping) * CELL_SIZE);
+      }
+      throw MedException("Heap is too small for the noise pages");
+    }
+
+    const AddressPairs& getMappings() {
+      return mappings;
+    }
+
+  private:
+    void fill(Byte* start, size_t size, const string& mode) {
+      if (mode == "zero") {
+        memset(start, 0, size); // Touch the pages, so that they are resident
+        return;
+      }
+      uint64_t* words = (uint64_t*)start;
+      for (size_t i = 0; i < size / sizeof(uint64_t); i++) {
+        words[i] = random.next();
+      }
+    }
+
+    Random& random;
+    AddressPairs mappings;
+    size_t cellsPerMapping;
+    set<size_t> used;
+  };
+
+  Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+      string arg = argv[i];
+      size_t eq = arg.find('=');
+      string key = arg.substr(0, eq);
+      string value = eq == string::npos ? "" : arg.substr(eq + 1);
+      if (key == "--size_mb") options.size = stoul(value) * 1024 * 1024;
+      else if (key == "--mappings") options.mappings = std::max(stoul(value), 1UL);
+      else if (key == "--seed") options.seed = stoull(value);
+      else if (key == "--fill") options.fill = value;
+      else if (key == "--values") options.values = stoul(value);
+      else if (key == "--value") options.value = stoi(value);
+      else if (key == "--structs") options.structs = stoul(value);
+      else if (key == "--chains") options.chains = std::min(stoul(value), sizeof(chainBases) / sizeof(Address));
+      else if (key == "--depth") options.depth = std::max(stoul(value), 1UL);
+      else if (key == "--strings") options.strings = stoul(value);
+      else if (key == "--counters") options.counters = stoul(value);
+      else if (key == "--noise_pages") options.noisePages = stoul(value);
+      else if (key == "--interval") options.interval = std::max(stoi(value), 1);
+      else if (key == "--truth") options.truth = value;
+      else {
+        cerr << "Unknown option " << arg << endl;
+        exit(1);
+      }
+    }
+    return options;
+  }
+
+  Json::Value addressToJson(Address address) {
+    return intToHex(address);
+  }
+
+  void plantValues(Heap& heap, const Options& options, Json::Value& truth) {
+    Json::Value& values = truth["values"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < options.values; i++) {
+      int32_t* address = (int32_t*)heap.takeCell();
+      *address = options.value;
+      values.append(addressToJson((Address)address));
+    }
+    truth["value"] = options.value;
+    truth["value_type"] = SCAN_TYPE_INT_32;
+  }
+
+  void plantStructs(Heap& heap, Random& random, const Options& options, Json::Value& truth) {
+    Json::Value& structs = truth["structs"] = Json::Value(Json::arrayValue);
+    truth["struct_layout"] = "int32 health; float32 speed; int16 level; int8 flag; int8 padding; int64 gold; float64 x";
+    for (size_t i = 0; i < options.structs; i++) {
+      PlantedStruct* s = (PlantedStruct*)heap.takeCell();
+      s->health = random.below(1000);
+      s->speed = random.below(10000) / 100.0f;
+      s->level = random.below(100);
+      s->flag = random.below(2);
+      s->padding = 0;
+      s->gold = random.below(1000000000);
+      s->x = random.below(1000000) / 1000.0;
+
+      Json::Value entry;
+      entry["address"] = addressToJson((Address)s);
+      entry["health"] = s->health;
+      entry["speed"] = s->speed;
+      entry["level"] = s->level;
+      entry["flag"] = s->flag;
+      entry["gold"] = (Json::Int64)s->gold;
+      entry["x"] = s->x;
+      structs.append(entry);
+    }
+  }
+
+  /**
+   * Each node is a cell with the pointer to the next node at a random offset,
+   * the last pointer points to the value.
+   */
+  void plantChains(Heap& heap, Random& random, const Options& options, const vector<Module>& modules, Json::Value& truth) {
+    Json::Value& chains = truth["chains"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < options.chains; i++) {
+      Json::Value entry;
+      Json::Value& offsets = entry["offsets"] = Json::Value(Json::arrayValue);
+      entry["base"] = addressToJson((Address)&chainBases[i]);
+      entry["base_module"] = addressToModuleOffset(modules, (Address)&chainBases[i]);
+
+      Address* pointer = &chainBases[i];
+      for (size_t d = 0; d < options.depth; d++) {
+        Byte* node = heap.takeCell();
+        size_t offset = random.below(CELL_SIZE / sizeof(Address)) * sizeof(Address);
+        *pointer = (Address)node;
+        if (d == options.depth - 1) {
+          *(int32_t*)(node + offset) = options.value;
+          entry["target"] = addressToJson((Address)(node + offset));
+        }
+        pointer = (Address*)(node + offset);
+        offsets.append((Json::UInt64)offset);
+      }
+      chains.append(entry);
+    }
+  }
+
+  void plantStrings(Heap& heap, Random& random, const Options& options, Json::Value& truth) {
+    Json::Value& strings = truth["strings"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < options.strings; i++) {
+      char* address = (char*)heap.takeCell();
+      char value[CELL_SIZE];
+      snprintf(value, sizeof(value), "med-%08" PRIx64, random.next() & 0xffffffff);
+      strcpy(address, value);
+
+      Json::Value entry;
+      entry["address"] = addressToJson((Address)address);
+      entry["value"] = value;
+      strings.append(entry);
+    }
+  }
+
+  vector<Counter> plantCounters(Heap& heap, Random& random, const Options& options, Json::Value& truth) {
+    vector<Counter> counters;
+    Json::Value& entries = truth["counters"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < options.counters; i++) {
+      Counter counter { (int32_t*)heap.takeCell(), (int32_t)random.below(10) + 1 };
+      *counter.address = random.below(1000);
+      counters.push_back(counter);
+
+      Json::Value entry;
+      entry["address"] = addressToJson((Address)counter.address);
+      entry["value"] = *counter.address;
+      entry["step"] = counter.step;
+      entries.append(entry);
+    }
+    return counters;
+  }
+
+  vector<Byte*> reserveNoise(Heap& heap, const Options& options, Json::Value& truth) {
+    vector<Byte*> pages;
+    Json::Value& entries = truth["noise_pages"] = Json::Value(Json::arrayValue);
+    for (size_t i = 0; i < options.noisePages; i++) {
+      pages.push_back(heap.takePage());
+      entries.append(addressToJson((Address)pages.back()));
+    }
+    return pages;
+  }
+
+  void writeTruth(const Json::Value& truth, const string& path) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    string json = Json::writeString(builder, truth);
+    if (path == "-") {
+      cout << json << endl;
+      return;
+    }
+    string temp = path + ".tmp";
+    {
+      ofstream file(temp);
+      file << json << endl;
+    }
+    rename(temp.c_str(), path.c_str());
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options = parseOptions(argc, argv);
+  Random random(options.seed);
+  Json::Value truth;
+
+  try {
+    Heap heap(options, random);
+    vector<Module> modules = getModules(getpid());
+
+    vector<Byte*> noise = reserveNoise(heap, options, truth);
+    plantValues(heap, options, truth);
+    plantStructs(heap, random, options, truth);
+    plantChains(heap, random, options, modules, truth);
+    plantStrings(heap, random, options, truth);
+    vector<Counter> counters = plantCounters(heap, random, options, truth);
+
+    truth["pid"] = getpid();
+    truth["seed"] = (Json::UInt64)options.seed;
+    truth["fill"] = options.fill;
+    truth["interval"] = options.interval;
+    truth["tick"] = addressToJson((Address)&tick);
+    truth["mappings_are_vmas"] = true; // Distinct regions in /proc/[pid]/maps, split by the guard pages
+    Json::Value& mappings = truth["mappings"] = Json::Value(Json::arrayValue);
+    for (auto& mapping : heap.getMappings()) {
+      Json::Value entry;
+      entry["start"] = addressToJson(mapping.first);
+      entry["end"] = addressToJson(mapping.second);
+      mappings.append(entry);
+    }
+    writeTruth(truth, options.truth);
+
+    size_t pageSize = getpagesize();
+    while (true) {
+      usleep(options.interval * 1000);
+      for (auto& counter : counters) {
+        *counter.address += counter.step;
+      }
+      for (auto page : noise) {
+        uint64_t* words = (uint64_t*)page;
+        for (size_t i = 0; i < pageSize / sizeof(uint64_t); i++) {
+          words[i] = random.next();
+        }
+      }
+      tick = tick + 1;
+    }
+  } catch (MedException& e) {
+    cerr << e.getMessage() << endl;
+    return 1;
+  }
+  return 0;
+}
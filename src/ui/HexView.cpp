@@ -0,0 +1,272 @@
+#include <cctype>
+#include <cstdio>
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <QKeyEvent>
+#include <QMouseEvent>
+
+#include "med/MedCommon.hpp"
+#include "ui/HexView.hpp"
+
+using namespace std;
+
+HexView::HexView(MemWindow* memWindow, QWidget* parent) : QAbstractScrollArea(parent) {
+  this->memWindow = memWindow;
+  rangeStart = 0;
+  baseAddress = 0;
+  cursorAddress = 0;
+  isLowNibble = false;
+
+  QFont font("FreeMono");
+  font.setStyleHint(QFont::Monospace);
+  font.setPixelSize(14);
+  setFont(font);
+  QFontMetrics metrics(font);
+  charWidth = metrics.horizontalAdvance('0');
+  lineHeight = metrics.height();
+  hexX = charWidth * 20; // Address and spaces
+  textX = hexX + charWidth * (HEX_VIEW_BYTES_PER_LINE * 3 + 1);
+
+  setFocusPolicy(Qt::StrongFocus);
+  setMinimumWidth(textX + charWidth * (HEX_VIEW_BYTES_PER_LINE + 2));
+  viewport()->setAutoFillBackground(true);
+}
+
+void HexView::setBaseAddress(Address address) {
+  baseAddress = address;
+  Address line = address - address % HEX_VIEW_BYTES_PER_LINE;
+  rangeStart = line > HEX_VIEW_BROWSE_SIZE ? line - HEX_VIEW_BROWSE_SIZE : 0;
+  updateScrollBar();
+  verticalScrollBar()->setValue((line - rangeStart) / HEX_VIEW_BYTES_PER_LINE);
+  setCursorAddress(address);
+  updateView();
+  refresh();
+}
+
+Address HexView::getBaseAddress() {
+  return baseAddress;
+}
+
+void HexView::setCursorAddress(Address address) {
+  cursorAddress = address;
+  isLowNibble = false;
+  ensureCursorVisible();
+  viewport()->update();
+  emit cursorAddressChanged(address);
+}
+
+Address HexView::getCursorAddress() {
+  return cursorAddress;
+}
+
+Address HexView::getTopAddress() {
+  return rangeStart + (Address)verticalScrollBar()->value() * HEX_VIEW_BYTES_PER_LINE;
+}
+
+int HexView::getVisibleLines() {
+  return viewport()->height() / lineHeight + 1;
+}
+
+void HexView::updateScrollBar() {
+  int lines = (HEX_VIEW_BROWSE_SIZE * 2) / HEX_VIEW_BYTES_PER_LINE;
+  verticalScrollBar()->setRange(0, std::max(lines - getVisibleLines() + 1, 0));
+  verticalScrollBar()->setPageStep(getVisibleLines() - 1);
+  verticalScrollBar()->setSingleStep(1);
+}
+
+/**
+ * The visible memory is shown from the cache, the prefetched pages cover the scrolling
+ */
+void HexView::updateView() {
+  memWindow->setView(getTopAddress(), getVisibleLines() * HEX_VIEW_BYTES_PER_LINE);
+  shownLines.clear();
+  viewport()->update();
+}
+
+void HexView::refresh() {
+  if (!baseAddress) {
+    return;
+  }
+  memWindow->update();
+
+  int lines = getVisibleLines();
+  if ((int)shownLines.size() != lines) {
+    viewport()->update();
+    return;
+  }
+
+  Address address = getTopAddress();
+  for (int i = 0; i < lines; i++) {
+    Line line = readLine(address + i * HEX_VIEW_BYTES_PER_LINE);
+    Line& shown = shownLines[i];
+    if (line.bytes != shown.bytes || line.readable != shown.readable || line.highlighted != shown.highlighted) {
+      viewport()->update(getLineRect(i));
+    }
+  }
+}
+
+HexView::Line HexView::readLine(Address address) {
+  Line line;
+  line.bytes.resize(HEX_VIEW_BYTES_PER_LINE);
+  line.readable.resize(HEX_VIEW_BYTES_PER_LINE);
+  line.highlighted.resize(HEX_VIEW_BYTES_PER_LINE);
+  for (int i = 0; i < HEX_VIEW_BYTES_PER_LINE; i++) {
+    line.readable[i] = memWindow->get(address + i, &line.bytes[i], 1);
+    line.highlighted[i] = line.readable[i] && memWindow->getAge(address + i) < HEX_VIEW_HIGHLIGHT_UPDATES;
+  }
+  return line;
+}
+
+QRect HexView::getLineRect(int line) {
+  return QRect(0, line * lineHeight, viewport()->width(), lineHeight);
+}
+
+void HexView::paintEvent(QPaintEvent* event) {
+  QPainter painter(viewport());
+  painter.setFont(font());
+  QColor textColor = palette().color(QPalette::Text);
+
+  int lines = getVisibleLines();
+  shownLines.resize(lines);
+  int first = event->rect().top() / lineHeight;
+  int last = std::min(event->rect().bottom() / lineHeight, lines - 1);
+  Address top = getTopAddress();
+
+  char hex[4];
+  for (int i = first; i <= last; i++) {
+    Address address = top + i * HEX_VIEW_BYTES_PER_LINE;
+    Line line = readLine(address);
+    int y = i * lineHeight;
+    int baseline = y + painter.fontMetrics().ascent();
+
+    painter.setPen(textColor);
+    painter.drawText(0, baseline, QString::fromStdString(intToHex(address)));
+
+    for (int j = 0; j < HEX_VIEW_BYTES_PER_LINE; j++) {
+      int x = hexX + j * 3 * charWidth;
+      int tx = textX + j * charWidth;
+      if (address + j == cursorAddress) {
+        QColor cursorColor = palette().color(QPalette::Highlight);
+        painter.fillRect(x + (isLowNibble ? charWidth : 0), y, charWidth, lineHeight, cursorColor);
+        painter.fillRect(tx, y, charWidth, lineHeight, cursorColor.lighter(150));
+      }
+
+      painter.setPen(line.highlighted[j] ? QColor(Qt::red) : textColor);
+      if (!line.readable[j]) {
+        painter.drawText(x, baseline, "??");
+        painter.drawText(tx, baseline, " ");
+        continue;
+      }
+      sprintf(hex, "%02x", line.bytes[j]);
+      painter.drawText(x, baseline, hex);
+      char ch = isprint(line.bytes[j]) ? line.bytes[j] : '.';
+      painter.drawText(tx, baseline, QString(QChar(ch)));
+    }
+    shownLines[i] = line;
+  }
+}
+
+void HexView::keyPressEvent(QKeyEvent* event) {
+  int key = event->key();
+  switch (key) {
+  case Qt::Key_Left:
+    moveCursor(-1);
+    return;
+  case Qt::Key_Right:
+    moveCursor(1);
+    return;
+  case Qt::Key_Up:
+    moveCursor(-HEX_VIEW_BYTES_PER_LINE);
+    return;
+  case Qt::Key_Down:
+    moveCursor(HEX_VIEW_BYTES_PER_LINE);
+    return;
+  case Qt::Key_PageUp:
+    moveCursor(-(long)verticalScrollBar()->pageStep() * HEX_VIEW_BYTES_PER_LINE);
+    return;
+  case Qt::Key_PageDown:
+    moveCursor((long)verticalScrollBar()->pageStep() * HEX_VIEW_BYTES_PER_LINE);
+    return;
+  }
+
+  int nibble = -1;
+  if (key >= Qt::Key_0 && key <= Qt::Key_9) {
+    nibble = key - Qt::Key_0;
+  }
+  else if (key >= Qt::Key_A && key <= Qt::Key_F) {
+    nibble = key - Qt::Key_A + 10;
+  }
+  Byte value;
+  if (nibble == -1 || !memWindow->get(cursorAddress, &value, 1)) {
+    QAbstractScrollArea::keyPressEvent(event);
+    return;
+  }
+
+  value = isLowNibble ? (value & 0xf0) | nibble : (value & 0x0f) | (nibble << 4);
+  emit byteEdited(cursorAddress, value);
+  if (isLowNibble) {
+    moveCursor(1);
+  }
+  else {
+    isLowNibble = true;
+    viewport()->update(getLineRect((cursorAddress - getTopAddress()) / HEX_VIEW_BYTES_PER_LINE));
+  }
+}
+
+void HexView::mousePressEvent(QMouseEvent* event) {
+  int line = event->pos().y() / lineHeight;
+  int x = event->pos().x();
+  int column;
+  if (x >= textX) {
+    column = (x - textX) / charWidth;
+  }
+  else if (x >= hexX) {
+    column = (x - hexX) / (3 * charWidth);
+  }
+  else {
+    return;
+  }
+  if (column >= HEX_VIEW_BYTES_PER_LINE) {
+    return;
+  }
+  setCursorAddress(getTopAddress() + line * HEX_VIEW_BYTES_PER_LINE + column);
+}
+
+void HexView::resizeEvent(QResizeEvent* event) {
+  QAbstractScrollArea::resizeEvent(event);
+  updateScrollBar();
+  updateView();
+}
+
+void HexView::scrollContentsBy(int, int) {
+  updateView();
+}
+
+void HexView::moveCursor(long offset) {
+  if (offset < 0 && cursorAddress < (Address)-offset) {
+    return;
+  }
+  Address address = cursorAddress + offset;
+  if (address < rangeStart || address >= rangeStart + HEX_VIEW_BROWSE_SIZE * 2) {
+    setBaseAddress(address); // Beyond the scrollable range
+    return;
+  }
+  setCursorAddress(address);
+}
+
+void HexView::ensureCursorVisible() {
+  if (cursorAddress < rangeStart) {
+    return;
+  }
+  long line = (cursorAddress - rangeStart) / HEX_VIEW_BYTES_PER_LINE;
+  long top = verticalScrollBar()->value();
+  long lines = std::max(getVisibleLines() - 1, 1);
+  if (line < top) {
+    verticalScrollBar()->setValue(line);
+  }
+  else if (line >= top + lines) {
+    verticalScrollBar()->setValue(line - lines + 1);
+  }
+}
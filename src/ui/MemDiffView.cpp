@@ -0,0 +1,176 @@
+#include <iostream>
+
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QPushButton>
+
+#include "ui/MemDiffView.hpp"
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+MemDiffView::MemDiffView(MedUi* mainUi) : QWidget(NULL, Qt::SubWindow) {
+  this->mainUi = mainUi;
+  memDiff = new MemDiff(mainUi->med->getMemIO());
+  hasSnapshotA = false;
+  hasSnapshotB = false;
+  setWindowTitle("Memory Diff");
+
+  addressLine = new QLineEdit();
+  addressLine->setPlaceholderText("Address");
+  sizeLine = new QLineEdit("4096");
+  sizeLine->setPlaceholderText("Size");
+  gapLine = new QLineEdit("0");
+  gapLine->setPlaceholderText("Gap");
+  gapLine->setToolTip("Changes separated by at most this number of bytes are shown as one range");
+  scanTypeCombo = new QComboBox();
+  scanTypeCombo->addItems({ "int8", "int16", "int32", "int64", "float32", "float64", "string", "ptr32", "ptr64" });
+  scanTypeCombo->setCurrentIndex(2); // int32
+
+  QHBoxLayout* regionLayout = new QHBoxLayout();
+  regionLayout->addWidget(addressLine);
+  regionLayout->addWidget(sizeLine);
+  regionLayout->addWidget(gapLine);
+  regionLayout->addWidget(scanTypeCombo);
+
+  QPushButton* snapshotAButton = new QPushButton("Snapshot &A");
+  QPushButton* snapshotBButton = new QPushButton("Snapshot &B");
+  QPushButton* diffButton = new QPushButton("&Diff A, B");
+  QPushButton* diffLiveButton = new QPushButton("Diff A, &Live");
+  QHBoxLayout* buttonLayout = new QHBoxLayout();
+  buttonLayout->addWidget(snapshotAButton);
+  buttonLayout->addWidget(snapshotBButton);
+  buttonLayout->addWidget(diffButton);
+  buttonLayout->addWidget(diffLiveButton);
+
+  resultTree = new QTreeWidget();
+  resultTree->setHeaderLabels({ "Address", "Offset", "Size", "Before", "After" });
+  resultTree->setUniformRowHeights(true);
+  statusLabel = new QLabel();
+
+  QVBoxLayout* layout = new QVBoxLayout();
+  layout->addLayout(regionLayout);
+  layout->addLayout(buttonLayout);
+  layout->addWidget(resultTree);
+  layout->addWidget(statusLabel);
+  setLayout(layout);
+  resize(600, 500);
+
+  QObject::connect(snapshotAButton, SIGNAL(clicked()), this, SLOT(onSnapshotAClicked()));
+  QObject::connect(snapshotBButton, SIGNAL(clicked()), this, SLOT(onSnapshotBClicked()));
+  QObject::connect(diffButton, SIGNAL(clicked()), this, SLOT(onDiffClicked()));
+  QObject::connect(diffLiveButton, SIGNAL(clicked()), this, SLOT(onDiffLiveClicked()));
+  QObject::connect(scanTypeCombo, SIGNAL(currentIndexChanged(int)), this, SLOT(onScanTypeComboChanged(int)));
+}
+
+MemDiffView::~MemDiffView() {
+  delete memDiff;
+}
+
+bool MemDiffView::readRegion(Address& address, size_t& size) {
+  if (mainUi->med->selectedProcess.pid == "") {
+    statusLabel->setText("No process selected");
+    return false;
+  }
+  try {
+    address = hexToInt(addressLine->text().trimmed().toStdString());
+    size = sizeLine->text().trimmed().toULong();
+  } catch (MedException& ex) {
+    statusLabel->setText(ex.what());
+    return false;
+  }
+  if (!address || !size) {
+    statusLabel->setText("Invalid address or size");
+    return false;
+  }
+  return true;
+}
+
+void MemDiffView::onSnapshotAClicked() {
+  Address address;
+  size_t size;
+  if (!readRegion(address, size)) {
+    return;
+  }
+  snapshotA = memDiff->take(address, size);
+  hasSnapshotA = true;
+  hasSnapshotB = false;
+  statusLabel->setText(QString("Snapshot A: %1 bytes").arg(size));
+}
+
+void MemDiffView::onSnapshotBClicked() {
+  if (!hasSnapshotA) {
+    statusLabel->setText("Take snapshot A first");
+    return;
+  }
+  snapshotB = memDiff->take(snapshotA.address, snapshotA.data.size());
+  hasSnapshotB = true;
+  statusLabel->setText(QString("Snapshot B: %1 bytes").arg(snapshotB.data.size()));
+}
+
+void MemDiffView::onDiffClicked() {
+  if (!hasSnapshotA || !hasSnapshotB) {
+    statusLabel->setText("Take snapshots A and B first");
+    return;
+  }
+  ranges = memDiff->compare(snapshotA, snapshotB, gapLine->text().toULong());
+  showRanges();
+}
+
+/**
+ * Live memory replaces the snapshot B, so that it can be compared again
+ */
+void MemDiffView::onDiffLiveClicked() {
+  if (!hasSnapshotA) {
+    statusLabel->setText("Take snapshot A first");
+    return;
+  }
+  ranges = memDiff->compareLive(snapshotA, snapshotB, gapLine->text().toULong());
+  hasSnapshotB = true;
+  showRanges();
+}
+
+void MemDiffView::onScanTypeComboChanged(int) {
+  if (hasSnapshotA && hasSnapshotB) {
+    showRanges();
+  }
+}
+
+void MemDiffView::showRanges() {
+  string scanType = scanTypeCombo->currentText().toStdString();
+  resultTree->clear();
+
+  QList<QTreeWidgetItem*> items;
+  for (size_t i = 0; i < ranges.size() && i < (size_t)MEM_DIFF_MAX_RANGES; i++) {
+    auto& range = ranges[i];
+    auto values = MemDiff::interpret(snapshotA, snapshotB, range, scanType);
+    QString offset = QString::fromStdString(intToHex(range.address - snapshotA.address));
+
+    QTreeWidgetItem* item = new QTreeWidgetItem();
+    item->setText(0, QString::fromStdString(intToHex(range.address)));
+    item->setText(1, offset);
+    item->setText(2, QString::number(range.size));
+    if (values.size() == 1) { // Single field is shown in the same row
+      item->setText(3, QString::fromStdString(values[0].before));
+      item->setText(4, QString::fromStdString(values[0].after));
+    }
+    else {
+      for (auto& value : values) {
+        QTreeWidgetItem* child = new QTreeWidgetItem(item);
+        child->setText(0, QString::fromStdString(intToHex(value.address)));
+        child->setText(1, QString::fromStdString(intToHex(value.address - snapshotA.address)));
+        child->setText(3, QString::fromStdString(value.before));
+        child->setText(4, QString::fromStdString(value.after));
+      }
+    }
+    items.append(item);
+  }
+  resultTree->addTopLevelItems(items);
+
+  QString message = QString("%1 changed ranges").arg(ranges.size());
+  if (ranges.size() > (size_t)MEM_DIFF_MAX_RANGES) {
+    message += QString(", first %1 shown").arg(MEM_DIFF_MAX_RANGES);
+  }
+  statusLabel->setText(message);
+}
@@ -71,19 +71,10 @@ void NamedScansController::onComboBoxChanged(int) {
 }
 
 void NamedScansController::updateScanTree() {
-  auto count = namedScans->getMemList()->size();
   mainUi->updateNumberOfAddresses();
 
   mainUi->scanUpdateMutex->lock();
-  mainUi->scanModel->clearAll();
-  mainUi->scanUpdateMutex->unlock();
-
-  if (count > SCAN_ADDRESS_VISIBLE_SIZE) {
-    return;
-  }
-
-  mainUi->scanUpdateMutex->lock();
-  mainUi->scanModel->addScan(namedScans->getScanType());
+  mainUi->scanModel->refresh();
   mainUi->scanUpdateMutex->unlock();
 }
 
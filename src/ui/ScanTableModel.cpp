@@ -0,0 +1,236 @@
+#include <iostream>
+
+#include "med/MedException.hpp"
+#include "mem/Pem.hpp"
+#include "ui/Ui.hpp"
+#include "ui/EncodingManager.hpp"
+#include "ui/ScanTableModel.hpp"
+
+using namespace std;
+
+ScanTableModel::ScanTableModel(MedUi* mainUi, QObject* parent) : QAbstractTableModel(parent) {
+  this->mainUi = mainUi;
+  this->med = mainUi->med;
+  count = 0;
+  isPartial = false;
+}
+
+QVariant ScanTableModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid())
+    return QVariant();
+
+  if (role != Qt::DisplayRole && role != Qt::EditRole && role != Qt::ToolTipRole)
+    return QVariant();
+
+  PemPtr pem = getPem(index.row());
+  if (!pem)
+    return QVariant();
+
+  if (role == Qt::ToolTipRole) { // Process of the value, in a multi-process session
+    return index.column() == SCAN_COL_ADDRESS ? QString("PID %1").arg(pem->getMemIO()->getPid()) : QVariant();
+  }
+
+  string scanType = isPartial ? partialScanType : pem->getScanType();
+  switch (index.column()) {
+  case SCAN_COL_ADDRESS:
+    return QString::fromStdString(pem->getAddressAsString());
+  case SCAN_COL_TYPE:
+    return QString::fromStdString(scanType);
+  case SCAN_COL_VALUE: {
+    auto it = values.find(index.row());
+    if (it != values.end()) {
+      return *it;
+    }
+    return QString::fromStdString(convertToUtf8(pem->recallValue(scanType), scanType));
+  }
+  case SCAN_COL_SUGGESTED:
+    return isPartial ? QVariant() : suggestions.value(index.row());
+  }
+  return QVariant();
+}
+
+bool ScanTableModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+  if (role != Qt::EditRole || isPartial)
+    return false;
+
+  int row = index.row();
+  auto list = med->getNamedScans().getMemList();
+  try {
+    if (index.column() == SCAN_COL_VALUE) {
+      string scanType = list->getScanType(row);
+      string newValue = value.toString().toStdString();
+      if (scanType == SCAN_TYPE_STRING) {
+        newValue = mainUi->encodingManager->encode(newValue);
+      }
+      list->setValue(row, newValue, scanType);
+      values[row] = value.toString();
+      emit dataChanged(index, index);
+      return true;
+    }
+    if (index.column() == SCAN_COL_TYPE) {
+      list->setScanType(row, value.toString().toStdString());
+      values.remove(row); // Until the value is read again
+      emit dataChanged(index, this->index(row, SCAN_COL_VALUE));
+      mainUi->refreshScanTreeView();
+      mainUi->valueCache->refresh();
+      return true;
+    }
+  } catch (MedException &e) {
+    cerr << "editScan: " << e.what() << endl;
+  }
+  return false;
+}
+
+Qt::ItemFlags ScanTableModel::flags(const QModelIndex &index) const {
+  if (!index.isValid())
+    return Qt::NoItemFlags;
+
+  if (isPartial || med->isScanning()) // Rows are the partial results, not the scan list
+    return QAbstractTableModel::flags(index);
+
+  if (index.column() == SCAN_COL_SUGGESTED)
+    return QAbstractTableModel::flags(index);
+
+  return Qt::ItemIsEditable | QAbstractTableModel::flags(index);
+}
+
+QVariant ScanTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return QVariant();
+
+  switch (section) {
+  case SCAN_COL_ADDRESS:
+    return "Address";
+  case SCAN_COL_TYPE:
+    return "Type";
+  case SCAN_COL_VALUE:
+    return "Value";
+  case SCAN_COL_SUGGESTED:
+    return "Suggested";
+  }
+  return QVariant();
+}
+
+int ScanTableModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return isPartial ? partial.size() : count;
+}
+
+int ScanTableModel::columnCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return 4;
+}
+
+void ScanTableModel::refresh() {
+  beginResetModel();
+  partial.clear();
+  isPartial = false;
+  values.clear();
+  suggestions.clear();
+  count = med->getNamedScans().getMemList()->size();
+  endResetModel();
+}
+
+void ScanTableModel::clearAll() {
+  beginResetModel();
+  partial.clear();
+  isPartial = false;
+  values.clear();
+  suggestions.clear();
+  count = 0;
+  endResetModel();
+}
+
+void ScanTableModel::addPartial(const vector<MemPtr>& mems, const string& scanType, int limit) {
+  if (!isPartial) {
+    clearAll();
+    isPartial = true;
+  }
+  size_t size = std::min(mems.size(), (size_t)std::max(limit - rowCount(), 0));
+  if (size == 0) {
+    return;
+  }
+  beginInsertRows(QModelIndex(), rowCount(), rowCount() + size - 1);
+  partialScanType = scanType;
+  partial.insert(partial.end(), mems.begin(), mems.begin() + size);
+  endInsertRows();
+}
+
+void ScanTableModel::applyValues(const vector<CachedValue>& cachedValues) {
+  if (isPartial) {
+    return;
+  }
+  auto& list = med->getNamedScans().getMemList()->getList();
+  QHash<int, QString> newValues;
+  int first = -1;
+  int last = -1;
+  for (auto& cached : cachedValues) {
+    int row = cached.row;
+    if (row >= rowCount() || cached.row >= list.size() || list[row]->getAddress() != cached.address) {
+      continue; // Rows are changed after the request
+    }
+    string scanType = static_pointer_cast<Pem>(list[row])->getScanType();
+    QString value = QString::fromStdString(convertToUtf8(cached.value, scanType));
+    newValues[row] = value;
+
+    auto it = values.find(row);
+    if (it != values.end() && *it == value) {
+      continue;
+    }
+    first = first == -1 ? row : std::min(first, row);
+    last = std::max(last, row);
+  }
+  values.swap(newValues);
+  if (first != -1) {
+    emit dataChanged(index(first, SCAN_COL_VALUE), index(last, SCAN_COL_VALUE));
+  }
+}
+
+void ScanTableModel::empty() {
+  med->clearScans();
+  clearAll();
+}
+
+void ScanTableModel::setSuggestions(const vector<Address>& addresses, const vector<TypeGuess>& guesses) {
+  if (isPartial || rowCount() == 0) {
+    return;
+  }
+  auto& list = med->getNamedScans().getMemList()->getList();
+  suggestions.clear();
+  for (size_t row = 0; row < addresses.size() && row < guesses.size() && row < (size_t)rowCount(); row++) {
+    if (row >= list.size() || list[row]->getAddress() != addresses[row]) {
+      break; // The list is replaced after sampling
+    }
+    auto& guess = guesses[row];
+    if (guess.kind == "unknown") {
+      continue;
+    }
+    suggestions[row] = QString("%1 (%2%)")
+      .arg(QString::fromStdString(guess.scanType))
+      .arg((int)(guess.confidence * 100));
+  }
+  emit dataChanged(index(0, SCAN_COL_SUGGESTED), index(rowCount() - 1, SCAN_COL_SUGGESTED));
+}
+
+PemPtr ScanTableModel::getPem(int row) const {
+  if (isPartial) {
+    if (row >= (int)partial.size()) {
+      return NULL;
+    }
+    return static_pointer_cast<Pem>(partial[row]);
+  }
+  auto& list = med->getNamedScans().getMemList()->getList();
+  if (row >= (int)count || row >= (int)list.size()) {
+    return NULL;
+  }
+  return static_pointer_cast<Pem>(list[row]);
+}
+
+string ScanTableModel::convertToUtf8(const string& str, const string& scanType) const {
+  if (scanType == SCAN_TYPE_STRING) {
+    return mainUi->encodingManager->convertToUtf8(str);
+  }
+  return str;
+}
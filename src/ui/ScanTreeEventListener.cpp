@@ -23,7 +23,7 @@ bool ScanTreeEventListener::eventFilter(QObject*, QEvent* ev) {
       QWidget* focused = mainUi->mainWindow->focusWidget();
       if (focused == treeView) {
         QModelIndex index = treeView->currentIndex();
-        if (index.column() == SCAN_COL_VALUE && mainUi->getScanState() == UiState::Idle) {
+        if (index.column() == SCAN_COL_VALUE && mainUi->getScanState() == UiState::Idle && !mainUi->med->isScanning()) {
           mainUi->scanUpdateMutex->lock();
           mainUi->setScanState(UiState::Editing);
         }
@@ -32,6 +32,19 @@ QVariant StoreTreeModel::data(const QModelIndex &index, int role) const {
   if (!index.isValid())
     return QVariant();
 
+  if (role == Qt::ToolTipRole && index.column() == STORE_COL_LOCK) {
+    auto& list = med->getStore()->getList();
+    if (index.row() >= (int)list.size()) {
+      return QVariant();
+    }
+    auto sem = static_pointer_cast<Sem>(list[index.row()]);
+    return QString("Corrected %1 times").arg(sem->getCorrections());
+  }
+
+  if (role == Qt::ForegroundRole && index.column() == STORE_COL_VALUE) {
+    return getHighlight(index.row());
+  }
+
   if (role != Qt::DisplayRole && role != Qt::EditRole)
     return QVariant();
 
@@ -60,7 +73,7 @@ bool StoreTreeModel::setData(const QModelIndex &index, const QVariant &value, in
   }
   else if (index.column() == STORE_COL_LOCK) {
     auto sem = static_pointer_cast<Sem>(med->getStore()->getList()[index.row()]);
-    sem->lock(value.toBool());
+    med->setLocked(sem, value.toBool());
   }
   else if (index.column() == STORE_COL_DESCRIPTION) {
     auto sem = static_pointer_cast<Sem>(med->getStore()->getList()[index.row()]);
@@ -89,35 +102,21 @@ Qt::ItemFlags StoreTreeModel::flags(const QModelIndex &index) const {
   return flags;
 }
 
-void StoreTreeModel::refreshValues() {
-  if (rowCount() == 0)
-    return;
-  QModelIndex first = index(0, STORE_COL_VALUE);
-  QModelIndex last = index(rowCount() - 1, STORE_COL_VALUE);
-
-  auto store = med->getStore();
-  for (int i = 0; i < rowCount(); i++) {
-    string value;
-    try {
-      value = store->getValue(i);
-    } catch (const MedException &ex) {}
-    QModelIndex modelIndex = index(i, STORE_COL_VALUE);
-    setItemData(modelIndex, QString::fromStdString(value));
-  }
-  emit dataChanged(first, last);
+void StoreTreeModel::applyValues(const vector<CachedValue>& values) {
+  TreeModel::applyValues(values, med->getStore(), STORE_COL_VALUE);
 }
 
 void StoreTreeModel::refresh() {
-  this->clearAll();
   auto store = med->getStore();
+  auto values = store->getValues(); // Read in batch
+
+  beginResetModel(); // Instead of inserting row by row
+  rootItem->removeChildren(0, rootItem->childCount());
+  clearChanges();
   for (size_t i = 0; i < store->size(); i++) {
     string address = store->getAddressAsString(i);
-    string value;
-    try {
-      value = store->getValue(i);
-    } catch (const MedException &ex) {
-      cerr << "Exception throw in refresh" << endl;
-    }
+    string scanType = store->getScanType(i);
+    string value = convertToUtf8(values[i], scanType);
 
     auto sem = static_pointer_cast<Sem>(med->getStore()->getList()[i]);
     string description = sem->getDescription();
@@ -126,13 +125,13 @@ void StoreTreeModel::refresh() {
     QVector<QVariant> data;
     data << description.c_str() <<
       address.c_str() <<
-      store->getScanType(i).c_str() <<
+      scanType.c_str() <<
       value.c_str() <<
       lock;
 
-    TreeItem* childItem = new TreeItem(data, this->root());
-    this->appendRow(childItem);
+    rootItem->appendChild(new TreeItem(data, rootItem));
   }
+  endResetModel();
 }
 
 void StoreTreeModel::addRow() {
@@ -0,0 +1,96 @@
+#include "med/MedCommon.hpp"
+#include "ui/StructTableModel.hpp"
+
+using namespace std;
+
+StructTableModel::StructTableModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+QVariant StructTableModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return QVariant();
+
+  size_t row = index.row();
+  if (row >= addresses.size())
+    return QVariant();
+
+  if (index.column() == 0) {
+    return QString::fromStdString(intToHex(addresses[row]));
+  }
+  size_t field = index.column() - 1;
+  if (row >= values.size() || field >= values[row].size())
+    return QVariant();
+  return QString::fromStdString(values[row][field]);
+}
+
+QVariant StructTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return QVariant();
+
+  if (section == 0) {
+    return QString("Address");
+  }
+  if ((size_t)section - 1 < fieldNames.size()) {
+    return QString::fromStdString(fieldNames[section - 1]);
+  }
+  return QVariant();
+}
+
+int StructTableModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return addresses.size();
+}
+
+int StructTableModel::columnCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return fieldNames.size() + 1;
+}
+
+void StructTableModel::reset(const vector<Address>& addresses, const vector<string>& fieldNames) {
+  beginResetModel();
+  this->addresses = addresses;
+  this->fieldNames = fieldNames;
+  values.clear();
+  endResetModel();
+}
+
+void StructTableModel::setValues(const vector<vector<string>>& values) {
+  if (values.size() != addresses.size()) {
+    return;
+  }
+  if (this->values.size() != values.size()) {
+    this->values = values;
+    emitRowsChanged(0, (int)values.size() - 1);
+    return;
+  }
+
+  int first = -1;
+  for (size_t i = 0; i < values.size(); i++) {
+    bool changed = this->values[i] != values[i];
+    if (changed) {
+      this->values[i] = values[i];
+      if (first < 0) {
+        first = i;
+      }
+    }
+    else if (first >= 0) {
+      emitRowsChanged(first, i - 1);
+      first = -1;
+    }
+  }
+  if (first >= 0) {
+    emitRowsChanged(first, values.size() - 1);
+  }
+}
+
+const vector<Address>& StructTableModel::getAddresses() {
+  return addresses;
+}
+
+void StructTableModel::emitRowsChanged(int first, int last) {
+  if (first > last) {
+    return;
+  }
+  emit dataChanged(index(first, 1), index(last, columnCount() - 1));
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTimer>
+#include <QFontDatabase>
+#include <QHeaderView>
+
+#include "ui/StructView.hpp"
+#include "med/MedCommon.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+namespace {
+  const QString DEFAULT_TEMPLATE =
+    "# name offset type, such as int32[4], string[16], or ptr64 { ... }\n"
+    "value 0x0 int32\n";
+}
+
+StructView::StructView(MedUi* mainUi) : QWidget(NULL, Qt::SubWindow) {
+  this->mainUi = mainUi;
+  setWindowTitle("Struct Dissector");
+
+  templateEdit = new QPlainTextEdit(DEFAULT_TEMPLATE);
+  templateEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+  addressLine = new QLineEdit();
+  addressLine->setPlaceholderText("Address");
+  QPushButton* applyAddressButton = new QPushButton("Apply to &address");
+  QPushButton* applyScanListButton = new QPushButton("Apply to &scan list");
+  QHBoxLayout* applyLayout = new QHBoxLayout();
+  applyLayout->addWidget(addressLine);
+  applyLayout->addWidget(applyAddressButton);
+  applyLayout->addWidget(applyScanListButton);
+
+  model = new StructTableModel(this);
+  tableView = new QTableView();
+  tableView->setModel(model);
+  tableView->verticalHeader()->setDefaultSectionSize(tableView->fontMetrics().height() + 4);
+  statusLabel = new QLabel();
+
+  QSplitter* splitter = new QSplitter(Qt::Vertical);
+  splitter->addWidget(templateEdit);
+  splitter->addWidget(tableView);
+  splitter->setStretchFactor(1, 1);
+
+  QVBoxLayout* layout = new QVBoxLayout();
+  layout->addWidget(splitter);
+  layout->addLayout(applyLayout);
+  layout->addWidget(statusLabel);
+  setLayout(layout);
+  resize(700, 600);
+
+  refreshTimer = new QTimer(this);
+
+  QObject::connect(applyAddressButton, SIGNAL(clicked()), this, SLOT(onApplyAddressClicked()));
+  QObject::connect(applyScanListButton, SIGNAL(clicked()), this, SLOT(onApplyScanListClicked()));
+  QObject::connect(refreshTimer, SIGNAL(timeout()), this, SLOT(onRefreshTimeout()));
+}
+
+StructView::~StructView() {}
+
+void StructView::showEvent(QShowEvent* event) {
+  QWidget::showEvent(event);
+  refreshTimer->start(STRUCT_VIEW_REFRESH_RATE);
+}
+
+void StructView::hideEvent(QHideEvent* event) {
+  QWidget::hideEvent(event);
+  refreshTimer->stop();
+}
+
+/**
+ * The current template is kept if the new one is invalid
+ */
+bool StructView::compileTemplate() {
+  try {
+    StructTemplate compiled(templateEdit->toPlainText().toStdString());
+    if (compiled.getNumOfFields() == 0) {
+      statusLabel->setText("No field in the template");
+      return false;
+    }
+    structTemplate = compiled;
+  } catch (MedException& ex) {
+    statusLabel->setText(ex.what());
+    return false;
+  }
+  return true;
+}
+
+void StructView::onApplyAddressClicked() {
+  Address address;
+  try {
+    address = hexToInt(addressLine->text().trimmed().toStdString());
+  } catch (MedException& ex) {
+    statusLabel->setText(ex.what());
+    return;
+  }
+  apply({ address });
+}
+
+void StructView::onApplyScanListClicked() {
+  MemList list = mainUi->med->getScans();
+  vector<Address> addresses;
+  for (size_t i = 0; i < list.size() && i < (size_t)STRUCT_VIEW_MAX_INSTANCES; i++) {
+    addresses.push_back(list.getAddress(i));
+  }
+  apply(addresses);
+
+  if (list.size() > (size_t)STRUCT_VIEW_MAX_INSTANCES) {
+    statusLabel->setText(QString("First %1 of %2 scan results").arg(STRUCT_VIEW_MAX_INSTANCES).arg(list.size()));
+  }
+}
+
+void StructView::apply(const vector<Address>& addresses) {
+  if (mainUi->med->selectedProcess.pid == "") {
+    statusLabel->setText("No process selected");
+    return;
+  }
+  if (!compileTemplate()) {
+    return;
+  }
+  model->reset(addresses, structTemplate.getFieldNames());
+  statusLabel->setText(QString("%1 instances, %2 fields").arg(addresses.size()).arg(structTemplate.getNumOfFields()));
+  onRefreshTimeout();
+}
+
+void StructView::onRefreshTimeout() {
+  auto& addresses = model->getAddresses();
+  if (addresses.size() == 0 || mainUi->med->selectedProcess.pid == "") {
+    return;
+  }
+  model->setValues(structTemplate.read(mainUi->med->getMemIO(), addresses));
+}
@@ -1,8 +1,10 @@
 #include <QtWidgets>
+#include <algorithm>
 #include <iostream>
 #include <cstdio>
 
 #include "med/MedException.hpp"
+#include "mem/Pem.hpp"
 #include "ui/Ui.hpp"
 #include "ui/EncodingManager.hpp"
 #include "ui/TreeItem.hpp"
@@ -17,6 +19,8 @@ TreeModel::TreeModel(MedUi* mainUi, QObject* parent) : QAbstractItemModel(parent
 
   this->mainUi = mainUi;
   this->med = mainUi->med;
+  highlightChanges = true;
+  highlightColumn = 0;
 }
 
 TreeModel::~TreeModel() {
@@ -193,37 +197,83 @@ TreeItem* TreeModel::getItem(const QModelIndex &index) const {
 
 void TreeModel::clearAll() {
   removeRows(0, rowCount());
+  clearChanges();
 }
 
-void TreeModel::addScan(string scanType) {
-  this->clearAll();
-  auto scans = med->getScans();
-  for(size_t i = 0; i < scans.size(); i++) {
-    string address = scans.getAddressAsString(i);
-    string value = scans.getValue(i, scanType);
+void TreeModel::applyValues(const vector<CachedValue>& values, MemList* list, int column) {
+  auto& mems = list->getList();
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  vector<int> changedRows;
+  highlightColumn = column;
+
+  // Highlight is removed when expired
+  for (auto it = changedAt.begin(); it != changedAt.end();) {
+    if (now - it.value() >= CHANGE_HIGHLIGHT_DURATION) {
+      changedRows.push_back(it.key());
+      it = changedAt.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
 
-    string newValue = convertToUtf8(value, scanType);
+  for (auto& cached : values) {
+    int row = cached.row;
+    if (row >= rowCount() || cached.row >= mems.size() || mems[row]->getAddress() != cached.address) {
+      continue; // Rows are changed after the request
+    }
+    string scanType = static_pointer_cast<Pem>(mems[row])->getScanType();
+    QVariant value = QString::fromStdString(convertToUtf8(cached.value, scanType));
+    TreeItem* item = getItem(index(row, column));
+    if (item->data(column) == value) {
+      continue;
+    }
+    item->setData(column, value);
+    if (highlightChanges) {
+      changedAt[row] = now;
+    }
+    changedRows.push_back(row);
+  }
+  emitRowsChanged(changedRows, column);
+}
 
-    QVector<QVariant> data;
-    data << address.c_str() << scanType.c_str() << newValue.c_str();
-    TreeItem* childItem = new TreeItem(data, this->root());
-    this->appendRow(childItem);
+/**
+ * Emit dataChanged for each run of adjacent rows, so that the unchanged rows are not repainted
+ */
+void TreeModel::emitRowsChanged(const vector<int>& rows, int column) {
+  vector<int> sorted = rows;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  for (size_t i = 0; i < sorted.size();) {
+    size_t j = i;
+    while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+      j++;
+    }
+    if (sorted[j] < rowCount()) {
+      emit dataChanged(index(sorted[i], column), index(sorted[j], column));
+    }
+    i = j + 1;
   }
 }
 
-void TreeModel::refreshValues() {
-  if (rowCount() == 0) {
-    return;
+QVariant TreeModel::getHighlight(int row) const {
+  if (!changedAt.contains(row)) {
+    return QVariant();
   }
-  QModelIndex first = index(0, SCAN_COL_VALUE);
-  QModelIndex last = index(rowCount() - 1, SCAN_COL_VALUE);
-  auto scans = med->getScans();
-  for (int i = 0; i < rowCount(); i++) {
-    string value = scans.getValue(i);
-    QModelIndex modelIndex = index(i, SCAN_COL_VALUE);
-    setItemData(modelIndex, QString::fromStdString(value));
+  return QColor(Qt::red);
+}
+
+void TreeModel::clearChanges() {
+  changedAt.clear();
+}
+
+void TreeModel::setHighlightChanges(bool value) {
+  highlightChanges = value;
+  if (!value) {
+    vector<int> rows(changedAt.keyBegin(), changedAt.keyEnd());
+    changedAt.clear();
+    emitRowsChanged(rows, highlightColumn);
   }
-  emit dataChanged(first, last);
 }
 
 void TreeModel::empty() {
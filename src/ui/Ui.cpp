@@ -3,6 +3,9 @@
 
 #include <QtUiTools>
 #include <QtDebug>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QTimer>
 
 #include "med/MedException.hpp"
 #include "med/MedCommon.hpp"
@@ -14,6 +17,8 @@
 #include "ui/CheckBoxDelegate.hpp"
 #include "ui/EncodingManager.hpp"
 #include "ui/MemEditor.hpp"
+#include "ui/MemDiffView.hpp"
+#include "ui/StructView.hpp"
 
 using namespace std;
 
@@ -22,6 +27,10 @@ MedUi::MedUi(QApplication* app) {
   this->autoRefresh = true;
   this->fastScan = true;
   this->forceResume = false;
+  writeTracer = NULL;
+  isSnapshotSave = false;
+  processExited = false;
+  recordScanText = "16 10 0x0 int32 <> 1 999; 0x8 float32 > 0";
   med = new MemEd();
   scanUpdateMutex = &med->getScanListMutex();
 
@@ -33,6 +42,9 @@ MedUi::MedUi(QApplication* app) {
   setupStoreTreeView();
   setupSignals();
   setupUi();
+  setupScanProgress();
+  setupValueCache();
+  setupTypeInference();
 
   encodingManager = new EncodingManager(this);
   setScanState(UiState::Idle);
@@ -42,12 +54,12 @@ MedUi::MedUi(QApplication* app) {
 }
 
 MedUi::~MedUi() {
+  delete valueCache; // Stop reading before the memory IO is deleted
+  delete typeAnalyzer;
+  delete writeTracer;
   delete med;
   delete encodingManager;
   delete namedScansController;
-
-  refreshThread->join();
-  delete refreshThread;
 }
 
 void MedUi::loadUiFiles() {
@@ -79,6 +91,8 @@ void MedUi::loadProcessUi() {
   processFile.close();
 
   processTreeWidget = processSelector->findChild<QTreeWidget*>("processTreeWidget");
+  processFilter = processSelector->findChild<QLineEdit*>("processFilter");
+  processMinRss = processSelector->findChild<QSpinBox*>("processMinRss");
 
   QVBoxLayout* layout = new QVBoxLayout();
   layout->addWidget(processSelector);
@@ -88,12 +102,17 @@ void MedUi::loadProcessUi() {
 
   //Add signal
   QObject::connect(processTreeWidget, SIGNAL(itemDoubleClicked(QTreeWidgetItem*, int)), this, SLOT(onProcessItemDblClicked(QTreeWidgetItem*, int)));
+  QObject::connect(processFilter, SIGNAL(textChanged(QString)), this, SLOT(onProcessFilterChanged()));
+  QObject::connect(processMinRss, SIGNAL(valueChanged(int)), this, SLOT(onProcessFilterChanged()));
 
   processTreeWidget->installEventFilter(new ProcessDialogEventListener(this));
+  processFilter->installEventFilter(new ProcessDialogEventListener(this));
 }
 
 void MedUi::loadMemEditor() {
   memEditor = new MemEditor(this);
+  memDiffView = new MemDiffView(this);
+  structView = new StructView(this);
 }
 
 void MedUi::setupUi() {
@@ -101,8 +120,6 @@ void MedUi::setupUi() {
   mainWindow->show();
   qRegisterMetaType<QVector<int>>(); // For multithreading
 
-  refreshThread = new std::thread(MedUi::refresh, this);
-
   QAction* showNotesAction = mainWindow->findChild<QAction*>("actionShowNotes");
   if (showNotesAction->isChecked()) {
     notesArea->show();
@@ -185,6 +202,10 @@ void MedUi::setupSignals() {
                    SIGNAL(triggered(bool)),
                    this,
                    SLOT(onAutoRefreshTriggered(bool)));
+  QObject::connect(mainWindow->findChild<QAction*>("actionHighlightChanges"),
+                   SIGNAL(triggered(bool)),
+                   this,
+                   SLOT(onHighlightChangesTriggered(bool)));
   QObject::connect(mainWindow->findChild<QAction*>("actionRefresh"),
                    SIGNAL(triggered()),
                    this,
@@ -201,10 +222,22 @@ void MedUi::setupSignals() {
                    SIGNAL(triggered(bool)),
                    this,
                    SLOT(onForceResumeTriggered(bool)));
+  QObject::connect(mainWindow->findChild<QAction*>("actionWriteOnlyIfChanged"),
+                   SIGNAL(triggered(bool)),
+                   this,
+                   SLOT(onWriteOnlyIfChangedTriggered(bool)));
   QObject::connect(mainWindow->findChild<QAction*>("actionUnlockAll"),
                    SIGNAL(triggered()),
                    this,
                    SLOT(onUnlockAllTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionLockInterval"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onLockIntervalTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionFindWrites"),
+                   SIGNAL(triggered(bool)),
+                   this,
+                   SLOT(onFindWritesTriggered(bool)));
 
   QObject::connect(mainWindow->findChild<QPushButton*>("nextAddress"),
                    SIGNAL(clicked()),
@@ -242,6 +275,26 @@ void MedUi::setupSignals() {
                    SIGNAL(triggered()),
                    this,
                    SLOT(onMemEditorTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionMemDiff"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onMemDiffTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionScanRecords"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onScanRecordsTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionInferTypes"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onInferTypesTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionStructView"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onStructViewTriggered()));
+  QObject::connect(mainWindow->findChild<QAction*>("actionSessionPids"),
+                   SIGNAL(triggered()),
+                   this,
+                   SLOT(onSessionPidsTriggered()));
 
   QObject::connect(mainWindow->findChild<QLineEdit*>("scopeStart"),
                    SIGNAL(editingFinished()),
@@ -254,7 +307,7 @@ void MedUi::setupSignals() {
 }
 
 void MedUi::setupScanTreeView() {
-  scanModel = new TreeModel(this, mainWindow);
+  scanModel = new ScanTableModel(this, mainWindow);
   scanTreeView->setModel(scanModel);
   scanTreeView->setColumnWidth(SCAN_COL_TYPE, 90);
   scanTreeView->setUniformRowHeights(true);
@@ -310,21 +363,46 @@ void MedUi::setupStoreTreeView() {
 }
 
 void MedUi::onProcessClicked() {
-  med->listProcesses();
   processDialog->show();
+  med->refreshProcesses();
+  onProcessFilterChanged();
+  processFilter->setFocus();
+}
+
+/**
+ * The processes are refreshed when the dialog opens, and only filtered on every key stroke.
+ * The process with the largest RSS is made current, ready to be chosen by Return.
+ */
+void MedUi::onProcessFilterChanged() {
+  med->filterProcesses(processFilter->text().toStdString(), (size_t)processMinRss->value() * 1024 * 1024);
   processTreeWidget->clear();
 
+  QTreeWidgetItem* largest = NULL;
+  size_t largestRss = 0;
   for (int i = med->processes.size() - 1; i >= 0; i--) {
+    const Process& process = med->processes[i];
     QTreeWidgetItem* item = new QTreeWidgetItem(processTreeWidget);
-    item->setText(0, med->processes[i].pid.c_str());
-    item->setText(1, med->processes[i].cmdline.c_str());
+    item->setText(0, process.pid.c_str());
+    item->setText(1, process.cmdline.c_str());
+    item->setText(2, QString::number(process.rss / 1024.0 / 1024.0, 'f', 1));
+    item->setToolTip(1, QString::fromStdString(process.exe));
+    if (!largest || process.rss > largestRss) {
+      largest = item;
+      largestRss = process.rss;
+    }
+  }
+  if (largest) {
+    processTreeWidget->setCurrentItem(largest);
+    processTreeWidget->scrollToItem(largest);
   }
 }
 
 void MedUi::onProcessItemDblClicked(QTreeWidgetItem* item, int) {
-  int index = item->treeWidget()->indexOfTopLevelItem(item); //Get the current row index
+  if (!item) {
+    return;
+  }
 
-  Process process = med->selectProcessByIndex(med->processes.size() - 1 - index);
+  Process process = med->selectProcess(item->text(0).toStdString());
 
   selectedProcessLine->setText(QString::fromLatin1((process.pid + " " + process.cmdline).c_str())); //Do not use fromStdString(), it will append with some unknown characters
 
@@ -336,6 +414,11 @@ string MedUi::getLastDigit() {
 }
 
 void MedUi::onScanClicked() {
+  if (med->isScanning()) {
+    med->cancelScan();
+    statusBar->showMessage("Cancelling");
+    return;
+  }
   if(med->selectedProcess.pid == "") {
     statusBar->showMessage("No process selected");
     return;
@@ -355,34 +438,63 @@ void MedUi::onScanClicked() {
   scanModel->clearAll();
   scanUpdateMutex->unlock();
 
-  try {
-    med->scan(scanValue, scanType, fastScan, getLastDigit());
-  } catch(EmptyListException &ex) {
-    statusBar->showMessage(ex.what());
-    cerr << ex.what() << endl;
+  progressScanType = scanType == SCAN_TYPE_CUSTOM ? SubCommand::getScanType(scanValue) : scanType;
+  isSnapshotSave = QString(scanValue.c_str()).trimmed() == "?";
+  startScanProgress(med->scanAsync(scanValue, scanType, fastScan, getLastDigit()));
+}
+
+/**
+ * The input is "stride min-records predicates", such as "16 10 0x0 int32 <> 1 999; 0x8 float32 > 0"
+ */
+void MedUi::onScanRecordsTriggered() {
+  if (med->isScanning()) {
+    statusBar->showMessage("Scanning");
+    return;
+  }
+  if(med->selectedProcess.pid == "") {
+    statusBar->showMessage("No process selected");
     return;
-  } catch(MedException &ex) {
-    cerr << "scan: "<< ex.what() << endl;
   }
 
-  if(med->getScans().size() <= SCAN_ADDRESS_VISIBLE_SIZE) {
-    scanUpdateMutex->lock();
-    string scanTypeToAdd = scanType == SCAN_TYPE_CUSTOM ? SubCommand::getScanType(scanValue) : scanType;
-    scanModel->addScan(scanTypeToAdd);
-    scanUpdateMutex->unlock();
+  bool ok;
+  QString text = QInputDialog::getText(mainWindow, "Scan Records",
+                                       "Stride, minimum records, and predicates \"offset type condition\" separated by \";\":",
+                                       QLineEdit::Normal, recordScanText, &ok);
+  if (!ok || text.trimmed() == "") {
+    return;
   }
+  recordScanText = text;
 
-  if (QString(scanValue.c_str()).trimmed() == "?") {
-    statusBar->showMessage("Snapshot saved");
+  QStringList parts = text.trimmed().split(' ', Qt::SkipEmptyParts);
+  if (parts.size() < 3) {
+    statusBar->showMessage("Expected \"stride min-records predicates\"");
+    return;
   }
-  updateNumberOfAddresses();
-  if (!med->getIsProcessPaused() && med->getCanResumeProcess()) {
-    med->resumeProcess();
+  size_t stride = parts[0].toULong();
+  size_t minRecords = parts[1].toULong();
+  string predicates = parts.mid(2).join(' ').toStdString();
+  try {
+    RecordMatcher matcher(predicates, stride, minRecords);
+    progressScanType = matcher.getScanType();
+  } catch (MedException& ex) {
+    statusBar->showMessage(ex.what());
+    return;
   }
-}
 
+  scanUpdateMutex->lock();
+  scanModel->clearAll();
+  scanUpdateMutex->unlock();
+
+  isSnapshotSave = false;
+  startScanProgress(med->scanRecordsAsync(predicates, stride, minRecords));
+}
 
 void MedUi::onFilterClicked() {
+  if (med->isScanning()) {
+    med->cancelScan();
+    statusBar->showMessage("Cancelling");
+    return;
+  }
   if(med->selectedProcess.pid == "") {
     statusBar->showMessage("No process selected");
     return;
@@ -398,27 +510,93 @@ void MedUi::onFilterClicked() {
     scanValue = encodingManager->encode(scanValue);
   }
 
-  try {
-    med->filter(scanValue, scanType, fastScan);
-  } catch (EmptyListException &ex) {
-    statusBar->showMessage(ex.what());
-    cerr << ex.what() << endl;
-    return;
-  } catch (MedException &ex) {
-    cerr << "filter: "<< ex.what() << endl;
+  scanUpdateMutex->lock();
+  scanModel->clearAll();
+  scanUpdateMutex->unlock();
+
+  progressScanType = scanType == SCAN_TYPE_CUSTOM ? SubCommand::getScanType(scanValue) : scanType;
+  isSnapshotSave = false;
+  startScanProgress(med->filterAsync(scanValue, scanType, fastScan));
+}
+
+void MedUi::setupScanProgress() {
+  scanButton = mainWindow->findChild<QPushButton*>("scanButton");
+  filterButton = mainWindow->findChild<QPushButton*>("filterButton");
+  scanTimer = new QTimer(this);
+  QObject::connect(scanTimer, SIGNAL(timeout()), this, SLOT(onScanProgressTimeout()));
+}
+
+void MedUi::startScanProgress(ScanProgressPtr progress) {
+  scanProgress = progress;
+  setScanning(true);
+  scanTimer->start(SCAN_PROGRESS_RATE);
+}
+
+/**
+ * Show the first hits and the progress while scanning, then the results when finished
+ */
+void MedUi::onScanProgressTimeout() {
+  auto partial = scanProgress->takePartial();
+  if (partial.size() > 0 && scanModel->rowCount() < SCAN_ADDRESS_VISIBLE_SIZE) {
+    scanUpdateMutex->lock();
+    scanModel->addPartial(partial, progressScanType, SCAN_ADDRESS_VISIBLE_SIZE);
+    scanUpdateMutex->unlock();
   }
 
-  if(med->getScans().size() <= SCAN_ADDRESS_VISIBLE_SIZE) {
-    string scanTypeToAdd = scanType == SCAN_TYPE_CUSTOM ? SubCommand::getScanType(scanValue) : scanType;
-    scanModel->addScan(scanType);
+  if (!scanProgress->isFinished()) {
+    char message[256];
+    sprintf(message, "%s %.0f%% (%zu / %zu MB, %zu / %zu regions), %zu found",
+            scanProgress->isCancelled() ? "Cancelling" : "Scanning",
+            scanProgress->getFraction() * 100,
+            scanProgress->getBytesDone() / 1024 / 1024, scanProgress->getBytesTotal() / 1024 / 1024,
+            scanProgress->getRegionsDone(), scanProgress->getRegionsTotal(),
+            scanProgress->getMatches());
+    statusBar->showMessage(message);
+    return;
   }
+  scanTimer->stop();
+  finishScanProgress();
+}
+
+void MedUi::finishScanProgress() {
+  setScanning(false);
+
+  // Rows are rebuilt from the scan list, so that they match the list order
+  scanUpdateMutex->lock();
+  scanModel->refresh();
+  scanUpdateMutex->unlock();
+  refreshScanTreeView();
+  valueCache->refresh();
 
+  string error = scanProgress->getError();
+  if (error != "") {
+    statusBar->showMessage(QString::fromStdString(error));
+    cerr << "scan: " << error << endl;
+  }
+  else if (isSnapshotSave) {
+    statusBar->showMessage("Snapshot saved");
+  }
+  else {
+    showScanStats();
+  }
   updateNumberOfAddresses();
   if (!med->getIsProcessPaused() && med->getCanResumeProcess()) {
     med->resumeProcess();
   }
 }
 
+/**
+ * While scanning, the scan and filter buttons cancel, and the scan list cannot be changed
+ */
+void MedUi::setScanning(bool scanning) {
+  scanButton->setText(scanning ? "&Cancel" : "&Scan");
+  filterButton->setText(scanning ? "&Cancel" : "F&ilter");
+  const char* names[] = { "scanAdd", "scanAddAll", "scanClear", "namedScans", "namedScan_add", "namedScan_delete" };
+  for (auto name : names) {
+    mainWindow->findChild<QWidget*>(name)->setEnabled(!scanning);
+  }
+}
+
 void MedUi::onPauseCheckboxClicked(bool checked) {
   if (checked) {
     med->pauseProcess();
@@ -436,7 +614,7 @@ void MedUi::onScanTreeViewClicked(const QModelIndex &index) {
 }
 
 void MedUi::onScanTreeViewDoubleClicked(const QModelIndex &index) {
-  if (index.column() == SCAN_COL_VALUE) {
+  if (index.column() == SCAN_COL_VALUE && !med->isScanning()) {
     scanUpdateMutex->lock();
     setScanState(UiState::Editing);
   }
@@ -444,7 +622,7 @@ void MedUi::onScanTreeViewDoubleClicked(const QModelIndex &index) {
 
 void MedUi::onScanTreeViewDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles) {
   // qDebug() << topLeft << bottomRight << roles;
-  if (topLeft.column() == SCAN_COL_VALUE) {
+  if (topLeft.column() == SCAN_COL_VALUE && getScanState() == UiState::Editing) { // Not by the refresh
     tryUnlock(*scanUpdateMutex);
     setScanState(UiState::Idle);
   }
@@ -467,7 +645,7 @@ void MedUi::onStoreTreeViewClicked(const QModelIndex &index) {
 }
 
 void MedUi::onStoreTreeViewDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles) {
-  if (topLeft.column() == STORE_COL_VALUE) {
+  if (topLeft.column() == STORE_COL_VALUE && getStoreState() == UiState::Editing) {
     tryUnlock(storeUpdateMutex);
     storeState = UiState::Idle;
   }
@@ -730,6 +908,12 @@ void MedUi::onAutoRefreshTriggered(bool checked) {
   }
 }
 
+void MedUi::onHighlightChangesTriggered(bool checked) {
+  storeUpdateMutex.lock();
+  storeModel->setHighlightChanges(checked);
+  storeUpdateMutex.unlock();
+}
+
 void MedUi::onFastScanTriggered(bool checked) {
   fastScan = checked;
 }
@@ -738,6 +922,10 @@ void MedUi::onForceResumeTriggered(bool checked) {
   forceResume = checked;
 }
 
+void MedUi::onWriteOnlyIfChangedTriggered(bool checked) {
+  med->setWriteOnlyIfChanged(checked);
+}
+
 void MedUi::onResumeProcessTriggered(bool checked) {
   if (checked) {
     med->setCanResumeProcess(true);
@@ -793,52 +981,223 @@ void MedUi::onMemEditorTriggered() {
   memEditor->show();
 }
 
+void MedUi::onMemDiffTriggered() {
+  memDiffView->show();
+}
+
+void MedUi::onStructViewTriggered() {
+  structView->show();
+}
+
+void MedUi::onSessionPidsTriggered() {
+  if (med->selectedProcess.pid == "") {
+    statusBar->showMessage("No process selected");
+    return;
+  }
+  if (med->isScanning()) {
+    statusBar->showMessage("Scanning");
+    return;
+  }
+
+  QStringList current;
+  for (auto pid : med->getSessionPids()) {
+    current << QString::number(pid);
+  }
+  bool ok;
+  QString text = QInputDialog::getText(mainWindow, "Session Processes",
+                                       "Process IDs scanned together, or \"tree\" for the selected process and its descendants:",
+                                       QLineEdit::Normal, current.join(' '), &ok);
+  if (!ok) {
+    return;
+  }
+
+  if (text.trimmed() == "tree") {
+    med->addProcessTree();
+  } else {
+    vector<pid_t> pids;
+    for (auto& part : text.split(' ', Qt::SkipEmptyParts)) {
+      pids.push_back(part.toInt());
+    }
+    med->setSessionPids(pids);
+  }
+
+  current.clear();
+  for (auto pid : med->getSessionPids()) {
+    current << QString::number(pid);
+  }
+  statusBar->showMessage("Session processes: " + current.join(' '));
+}
+
+void MedUi::showScanStats() {
+  ScanStats stats = med->getScanStats();
+  statusBar->showMessage(QString::fromStdString(stats.toSummary()));
+  statusBar->setToolTip(QString::fromStdString(stats.toString()));
+}
+
 void MedUi::updateNumberOfAddresses() {
   char message[128];
   sprintf(message, "%ld", med->getScans().size());
   mainWindow->findChild<QLabel*>("found")->setText(message);
 }
 
-void MedUi::refresh(MedUi* mainUi) {
-  // TODO: Store refresh if closing
-  while (1) {
-    if (mainUi->autoRefresh) {
-      mainUi->refreshScanTreeView();
-      mainUi->refreshStoreTreeView();
+/**
+ * The values are read by the value cache thread, so the GUI thread never waits for the memory reads.
+ * Only the visible rows are requested.
+ */
+void MedUi::setupValueCache() {
+  valueCache = new ValueCache(med->getMemIO());
+  valueCache->setInterval(REFRESH_RATE);
+  valueCache->setCallback([this]() { emit valuesRefreshed(); });
+  QObject::connect(this, SIGNAL(valuesRefreshed()), this, SLOT(onValuesRefreshed()), Qt::QueuedConnection);
+  valueCache->start();
+
+  refreshTimer = new QTimer(this);
+  QObject::connect(refreshTimer, SIGNAL(timeout()), this, SLOT(onRefreshTimeout()));
+  refreshTimer->start(REFRESH_RATE);
+
+  // Rows scrolled into view are requested without waiting for the timer
+  QObject::connect(scanTreeView->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(onRefreshTriggered()));
+  QObject::connect(storeTreeView->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(onRefreshTriggered()));
+}
+
+void MedUi::setupTypeInference() {
+  typeAnalyzer = new TypeAnalyzer(med->getMemIO());
+  inferTimer = new QTimer(this);
+  QObject::connect(inferTimer, SIGNAL(timeout()), this, SLOT(onInferTypesTimeout()));
+}
+
+/**
+ * Sample the values of the scan list over time, then show the suggested type of each row
+ */
+void MedUi::onInferTypesTriggered() {
+  if (inferTimer->isActive()) {
+    return;
+  }
+  if (med->selectedProcess.pid == "") {
+    statusBar->showMessage("No process selected");
+    return;
+  }
+  if (med->isScanning()) {
+    statusBar->showMessage("Scanning");
+    return;
+  }
+
+  MemList list = med->getScans();
+  vector<Address> addresses;
+  for (size_t i = 0; i < list.size() && i < (size_t)TYPE_INFERENCE_MAX_ADDRESSES; i++) {
+    addresses.push_back(list.getAddress(i));
+  }
+  if (addresses.size() == 0) {
+    statusBar->showMessage("No scan result");
+    return;
+  }
+  try {
+    typeAnalyzer->setMaps(getMaps(med->getPid(), false));
+  } catch (MedException& ex) {
+    statusBar->showMessage(ex.what());
+    return;
+  }
+  typeAnalyzer->setAddresses(addresses);
+  inferTimer->start(TYPE_INFERENCE_RATE);
+}
+
+void MedUi::onInferTypesTimeout() {
+  typeAnalyzer->sample();
+  size_t samples = typeAnalyzer->getNumOfSamples();
+  if (samples < (size_t)TYPE_INFERENCE_SAMPLES) {
+    statusBar->showMessage(QString("Sampling %1 / %2").arg(samples).arg(TYPE_INFERENCE_SAMPLES));
+    return;
+  }
+  inferTimer->stop();
+  scanModel->setSuggestions(typeAnalyzer->getAddresses(), typeAnalyzer->classify());
+  statusBar->showMessage(QString("Suggested the types of %1 addresses").arg(typeAnalyzer->getAddresses().size()));
+}
+
+void MedUi::onRefreshTimeout() {
+  size_t numOfUnlocked;
+  if (med->reattachIfRestarted(&numOfUnlocked)) {
+    processExited = false;
+    Process process = med->selectedProcess;
+    selectedProcessLine->setText(QString::fromLatin1((process.pid + " " + process.cmdline).c_str()));
+    QString message = QString("Re-attached to the restarted process %1").arg(process.pid.c_str());
+    if (numOfUnlocked > 0) {
+      message += QString(", %1 locked values outside the modules are unlocked").arg(numOfUnlocked);
     }
-    auto med = mainUi->med;
-    if (mainUi->forceResume && !med->getIsProcessPaused()) {
-      med->resumeProcess();
+    statusBar->showMessage(message);
+  } else if (med->isProcessExited() != processExited) {
+    processExited = !processExited;
+    if (processExited) {
+      statusBar->showMessage("Process exited, waiting for it to restart");
     }
-    std::this_thread::sleep_for(chrono::milliseconds(REFRESH_RATE));
+  }
+
+  if (autoRefresh) {
+    refreshScanTreeView();
+    refreshStoreTreeView();
+  }
+  if (forceResume && !med->getIsProcessPaused()) {
+    med->resumeProcess();
   }
 }
 
 void MedUi::onRefreshTriggered() {
   refreshScanTreeView();
   refreshStoreTreeView();
+  valueCache->refresh();
+}
+
+vector<ValueRequest> MedUi::getVisibleRequests(QTreeView* treeView, vector<MemPtr>& list) {
+  vector<ValueRequest> requests;
+  QAbstractItemModel* model = treeView->model();
+  int rows = std::min(model->rowCount(), (int)list.size());
+  if (rows == 0 || med->selectedProcess.pid == "") {
+    return requests;
+  }
+
+  QRect rect = treeView->viewport()->rect();
+  QModelIndex top = treeView->indexAt(rect.topLeft());
+  QModelIndex bottom = treeView->indexAt(rect.bottomLeft());
+  int first = top.isValid() ? top.row() : 0;
+  int last = bottom.isValid() ? bottom.row() : rows - 1;
+
+  for (int i = first; i <= std::min(last, rows - 1); i++) {
+    PemPtr pem = static_pointer_cast<Pem>(list[i]);
+    requests.push_back(ValueRequest { (size_t)i, pem->getAddress(), pem->getSize(), pem->getScanType(), pem->getMemIO() });
+  }
+  return requests;
 }
 
 void MedUi::refreshScanTreeView() {
-  scanUpdateMutex->lock();
-  try {
-    scanModel->refreshValues();
-  } catch (MedException& ex) {
-    scanUpdateMutex->unlock();
-    cerr << ex.getMessage() << endl;
+  if (med->isScanning()) { // Rows are the partial results, not the scan list
+    return;
   }
+  if (getScanState() == UiState::Editing || !scanUpdateMutex->try_lock()) {
+    return;
+  }
+  auto requests = getVisibleRequests(scanTreeView, med->getNamedScans().getMemList()->getList());
   scanUpdateMutex->unlock();
+  valueCache->setRequests("scan", requests);
 }
 
 void MedUi::refreshStoreTreeView() {
-  storeUpdateMutex.lock();
-  try {
-    storeModel->refreshValues();
-  } catch (MedException& ex) {
-    storeUpdateMutex.unlock();
-    cerr << ex.getMessage() << endl;
+  if (getStoreState() == UiState::Editing || !storeUpdateMutex.try_lock()) {
+    return;
   }
+  auto requests = getVisibleRequests(storeTreeView, med->getStore()->getList());
   storeUpdateMutex.unlock();
+  valueCache->setRequests("store", requests);
+}
+
+void MedUi::onValuesRefreshed() {
+  // The mutexes are held while editing, and the list may be changing by the scan
+  if (!med->isScanning() && getScanState() != UiState::Editing && scanUpdateMutex->try_lock()) {
+    scanModel->applyValues(valueCache->getValues("scan"));
+    scanUpdateMutex->unlock();
+  }
+  if (getStoreState() != UiState::Editing && storeUpdateMutex.try_lock()) {
+    storeModel->applyValues(valueCache->getValues("store"));
+    storeUpdateMutex.unlock();
+  }
 }
 
 UiState MedUi::getScanState() {
@@ -881,3 +1240,77 @@ void MedUi::onUnlockAllTriggered() {
   StoreTreeModel* model = dynamic_cast<StoreTreeModel*>(storeTreeView->model());
   model->unlockAll();
 }
+
+void MedUi::onLockIntervalTriggered() {
+  auto indexes = storeTreeView
+    ->selectionModel()
+    ->selectedRows(STORE_COL_ADDRESS);
+  if (indexes.size() == 0) {
+    return;
+  }
+
+  auto list = med->getStore()->getList();
+  auto first = static_pointer_cast<Sem>(list[indexes[0].row()]);
+  bool ok;
+  int ms = QInputDialog::getInt(mainWindow, "Lock Interval", "Interval of writing the locked value (ms):",
+                                first->getLockInterval(), 1, 60000, 1, &ok);
+  if (!ok) {
+    return;
+  }
+  for (auto i = 0; i < indexes.size(); i++) {
+    auto sem = static_pointer_cast<Sem>(list[indexes[i].row()]);
+    med->setLockInterval(sem, ms);
+  }
+}
+
+void MedUi::onFindWritesTriggered(bool checked) {
+  QAction* action = mainWindow->findChild<QAction*>("actionFindWrites");
+  if (!checked) {
+    if (!writeTracer) {
+      return;
+    }
+    writeTracer->stop();
+    auto hits = writeTracer->getHits();
+    delete writeTracer;
+    writeTracer = NULL;
+
+    QString text = hits.size() == 0 ? "No write is found" : "Count\tInstruction\n";
+    for (auto& hit : hits) {
+      text += QString("%1\t%2\n").arg(hit.count).arg(QString::fromStdString(hit.location));
+    }
+    statusBar->showMessage("Write tracing stopped");
+    QMessageBox::information(mainWindow, "Find What Writes", text);
+    return;
+  }
+
+  if (med->selectedProcess.pid == "") {
+    statusBar->showMessage("No process selected");
+    action->setChecked(false);
+    return;
+  }
+  auto indexes = storeTreeView
+    ->selectionModel()
+    ->selectedRows(STORE_COL_ADDRESS);
+  if (indexes.size() == 0) {
+    statusBar->showMessage("No address selected");
+    action->setChecked(false);
+    return;
+  }
+
+  auto sem = med->getStore()->getList()[indexes[0].row()];
+  size_t size = scanTypeToSize(static_pointer_cast<Sem>(sem)->getScanType());
+  if (size != 1 && size != 2 && size != 4 && size != 8) {
+    size = 1; // String and custom, trace the first byte
+  }
+  try {
+    writeTracer = new WriteTracer(med->getPid());
+    writeTracer->start(sem->getAddress(), size);
+    statusBar->showMessage(QString::fromStdString("Tracing writes to " + sem->getAddressAsString() +
+                                                  ", uncheck Find What Writes to show the result"));
+  } catch (MedException& e) {
+    delete writeTracer;
+    writeTracer = NULL;
+    action->setChecked(false);
+    statusBar->showMessage(e.what());
+  }
+}
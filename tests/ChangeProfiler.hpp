@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/ChangeProfiler.hpp"
+
+using namespace std;
+
+class TestChangeProfiler : public CxxTest::TestSuite {
+public:
+  void testSample() {
+    size_t pageSize = getpagesize();
+    Byte* memory = (Byte*)aligned_alloc(pageSize, pageSize * 4);
+    memset(memory, 0, pageSize * 4);
+    Address base = (Address)memory;
+
+    MemIO memio;
+    ChangeProfiler profiler(&memio);
+    profiler.setRegions({ AddressPair(base, base + pageSize * 4) });
+
+    profiler.sample();
+    memory[pageSize + 3 * CACHE_LINE_SIZE] = 1;
+    profiler.sample();
+    memory[pageSize + 5 * CACHE_LINE_SIZE + 1] = 1;
+    memory[pageSize * 2] = 1;
+    profiler.sample();
+
+    auto heatMap = profiler.getHeatMap();
+    TS_ASSERT_EQUALS(heatMap.size(), 4);
+    TS_ASSERT_EQUALS(heatMap[0].samples, 3);
+    TS_ASSERT_EQUALS(heatMap[0].changes, 0);
+    TS_ASSERT_EQUALS(heatMap[1].changes, 2);
+    TS_ASSERT_EQUALS(heatMap[1].rate, 1.0);
+    TS_ASSERT_EQUALS(heatMap[1].lineChanges[5], 1);
+    TS_ASSERT_EQUALS(heatMap[1].lineChanges[3], 0);
+    TS_ASSERT_EQUALS(heatMap[2].changes, 1);
+    TS_ASSERT_EQUALS(heatMap[3].lineChanges.size(), 0);
+
+    auto ranges = profiler.getVolatileRanges(0.5);
+    TS_ASSERT_EQUALS(ranges.size(), 1);
+    TS_ASSERT_EQUALS(ranges[0], AddressPair(base + pageSize, base + pageSize * 3));
+
+    free(memory);
+  }
+
+  void testSlice() {
+    size_t pageSize = getpagesize();
+    Byte* memory = (Byte*)aligned_alloc(pageSize, pageSize * 4);
+    memset(memory, 0, pageSize * 4);
+    Address base = (Address)memory;
+
+    MemIO memio;
+    ChangeProfiler profiler(&memio);
+    profiler.setRegions({ AddressPair(base, base + pageSize * 4) });
+    profiler.setSliceSize(pageSize * 3);
+
+    profiler.sample();
+    TS_ASSERT_EQUALS(profiler.getHeatMap().size(), 3);
+    profiler.sample();
+    auto heatMap = profiler.getHeatMap();
+    TS_ASSERT_EQUALS(heatMap.size(), 4);
+    TS_ASSERT_EQUALS(heatMap[0].samples, 1);
+
+    profiler.sample();
+    TS_ASSERT_EQUALS(profiler.getHeatMap()[0].samples, 2);
+
+    free(memory);
+  }
+};
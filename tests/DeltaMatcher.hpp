@@ -0,0 +1,74 @@
+#include <string>
+#include <cxxtest/TestSuite.h>
+
+#include "med/DeltaMatcher.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+class TestDeltaMatcher : public CxxTest::TestSuite {
+public:
+  void testIncreasedBy() {
+    DeltaMatcher matcher("+= 5", SCAN_TYPE_INT_32);
+    int oldValue = 100;
+    int newValue = 105;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), true);
+    newValue = 106;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+  }
+
+  void testIncreasedByWrapAround() {
+    DeltaMatcher matcher("+= 10", SCAN_TYPE_INT_8);
+    uint8_t oldValue = 250;
+    uint8_t newValue = 4;
+    TS_ASSERT_EQUALS(matcher.match(&newValue, &oldValue), true);
+  }
+
+  void testDecreasedByBetween() {
+    DeltaMatcher matcher("-= 2 10", SCAN_TYPE_FLOAT_32);
+    float oldValue = 50.0f;
+    float newValue = 45.5f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), true);
+    newValue = 39.0f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+    newValue = 55.0f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+  }
+
+  void testChangedByPercent() {
+    DeltaMatcher matcher("%< 10", SCAN_TYPE_INT_16);
+    uint16_t oldValue = 200;
+    uint16_t newValue = 215;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), true);
+    newValue = 180;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+  }
+
+  void testChangedByPercentOfNegative() {
+    DeltaMatcher matcher("%< 5", SCAN_TYPE_INT_32);
+    int32_t oldValue = -100;
+    int32_t newValue = -103;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), true);
+    newValue = 500;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+    newValue = -110;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&newValue, (Byte*)&oldValue), false);
+  }
+
+  void testMatchBlock() {
+    int oldBlock[] = { 10, 20, 30, 40 };
+    int newBlock[] = { 13, 20, 33, 37 };
+    DeltaMatcher matcher("+= 3", SCAN_TYPE_INT_32);
+    Byte mask[4];
+    TS_ASSERT_EQUALS(matcher.matchBlock((Byte*)newBlock, (Byte*)oldBlock, 4, sizeof(int), mask), 2);
+    TS_ASSERT_EQUALS(mask[0], 1);
+    TS_ASSERT_EQUALS(mask[1], 0);
+    TS_ASSERT_EQUALS(mask[2], 1);
+    TS_ASSERT_EQUALS(mask[3], 0);
+  }
+
+  void testInvalid() {
+    TS_ASSERT_THROWS(DeltaMatcher("> 3", SCAN_TYPE_INT_32), MedException&);
+    TS_ASSERT_THROWS(DeltaMatcher("+= 3", SCAN_TYPE_STRING), MedException&);
+  }
+};
@@ -0,0 +1,96 @@
+#include <string>
+#include <cmath>
+#include <cxxtest/TestSuite.h>
+
+#include "med/FloatMatcher.hpp"
+#include "med/ScanParser.hpp"
+#include "med/ScanCommand.hpp"
+
+using namespace std;
+
+class TestFloatMatcher : public CxxTest::TestSuite {
+public:
+  void testUlpDistance() {
+    float a = 1.0f;
+    float b = nextafterf(a, 2.0f);
+    TS_ASSERT_EQUALS(FloatMatcher::ulpDistance(a, a), 0);
+    TS_ASSERT_EQUALS(FloatMatcher::ulpDistance(a, b), 1);
+    TS_ASSERT_EQUALS(FloatMatcher::ulpDistance(0.0f, -0.0f), 0);
+    TS_ASSERT_EQUALS(FloatMatcher::ulpDistance(nextafterf(0.0f, 1.0f), nextafterf(0.0f, -1.0f)), 2);
+
+    double c = 12.5;
+    TS_ASSERT_EQUALS(FloatMatcher::ulpDistance(c, nextafter(nextafter(c, 0.0), 0.0)), 2);
+  }
+
+  void testAround() {
+    string s = "~ 12.5 0.01";
+    Operands operands = ScanParser::valueToOperands(s, SCAN_TYPE_FLOAT_32, ScanParser::OpType::Around);
+    FloatMatcher matcher(ScanType::Float32, operands, ScanParser::OpType::Around);
+
+    float value = 12.4999f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), true);
+    value = 12.52f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), false);
+    value = -12.5f;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), false);
+  }
+
+  void testNegativeOrdering() {
+    string s = "> -2";
+    Operands operands = ScanParser::valueToOperands(s, SCAN_TYPE_FLOAT_64, ScanParser::OpType::Gt);
+    FloatMatcher matcher(ScanType::Float64, operands, ScanParser::OpType::Gt);
+
+    double value = -1.5;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), true);
+    value = -3;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), false);
+  }
+
+  void testAroundUlp() {
+    string s = "~u 12.5 2";
+    Operands operands = ScanParser::valueToOperands(s, SCAN_TYPE_FLOAT_32, ScanParser::OpType::AroundUlp);
+    FloatMatcher matcher(ScanType::Float32, operands, ScanParser::OpType::AroundUlp);
+
+    float value = nextafterf(nextafterf(12.5f, 0.0f), 0.0f);
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), true);
+    value = nextafterf(value, 0.0f);
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&value), false);
+  }
+
+  void testRoundedAndTruncated() {
+    Operands operands = ScanParser::valueToOperands("~r 12", SCAN_TYPE_FLOAT_32, ScanParser::OpType::Rounded);
+    FloatMatcher rounded(ScanType::Float32, operands, ScanParser::OpType::Rounded);
+    operands = ScanParser::valueToOperands("~t 12", SCAN_TYPE_FLOAT_32, ScanParser::OpType::Truncated);
+    FloatMatcher truncated(ScanType::Float32, operands, ScanParser::OpType::Truncated);
+
+    float value = 12.37f;
+    TS_ASSERT_EQUALS(rounded.match((Byte*)&value), true);
+    TS_ASSERT_EQUALS(truncated.match((Byte*)&value), true);
+    value = 11.6f;
+    TS_ASSERT_EQUALS(rounded.match((Byte*)&value), true);
+    TS_ASSERT_EQUALS(truncated.match((Byte*)&value), false);
+  }
+
+  void testMatchBlock() {
+    float memory[] = { 1.0f, 12.4f, 12.6f, 13.0f, 12.49f };
+    Operands operands = ScanParser::valueToOperands("~ 12.5 0.2", SCAN_TYPE_FLOAT_32, ScanParser::OpType::Around);
+    FloatMatcher matcher(ScanType::Float32, operands, ScanParser::OpType::Around);
+
+    Byte mask[5];
+    size_t matched = matcher.matchBlock((Byte*)memory, 5, sizeof(float), mask);
+    TS_ASSERT_EQUALS(matched, 3);
+    TS_ASSERT_EQUALS(mask[0], 0);
+    TS_ASSERT_EQUALS(mask[1], 1);
+    TS_ASSERT_EQUALS(mask[3], 0);
+  }
+
+  void testScanCommand() {
+    ScanCommand scanCommand("~r 12", SCAN_TYPE_FLOAT_32);
+    float memory[] = { 12.37f, 11.2f };
+    TS_ASSERT_EQUALS(scanCommand.match((Byte*)&memory[0]), true);
+    TS_ASSERT_EQUALS(scanCommand.match((Byte*)&memory[1]), false);
+
+    Byte mask[2];
+    TS_ASSERT_EQUALS(scanCommand.matchBlock((Byte*)memory, 2, sizeof(float), mask), 1);
+  }
+};
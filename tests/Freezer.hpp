@@ -0,0 +1,97 @@
+#include <chrono>
+#include <thread>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/Freezer.hpp"
+
+using namespace std;
+
+class TestFreezer : public CxxTest::TestSuite {
+public:
+  void testFreeze() {
+    MemIO memio;
+    volatile int memory = 100;
+    SemPtr sem = SemPtr(new Sem((Address)&memory, 4, &memio));
+    sem->setScanType("int32");
+    sem->setLockInterval(1);
+    sem->lock(true);
+
+    Freezer freezer(&memio);
+    freezer.start();
+    freezer.add(sem);
+
+    memory = 20;
+    waitUntil([&memory]() { return memory == 100; });
+    TS_ASSERT_EQUALS(memory, 100);
+
+    sem->lock(false);
+    waitUntil([&freezer]() { return freezer.size() == 0; });
+    TS_ASSERT_EQUALS(freezer.size(), 0);
+    memory = 20;
+    this_thread::sleep_for(chrono::milliseconds(10));
+    TS_ASSERT_EQUALS(memory, 20);
+
+    freezer.stop();
+  }
+
+  void testReschedule() {
+    MemIO memio;
+    int memory = 1;
+    SemPtr sem = SemPtr(new Sem((Address)&memory, 4, &memio));
+    sem->setScanType("int32");
+    sem->lock(true);
+
+    Freezer freezer(&memio);
+    freezer.add(sem);
+    freezer.add(sem);
+    TS_ASSERT_EQUALS(freezer.size(), 1);
+  }
+
+  void testWriteOnlyIfChanged() {
+    MemIO memio;
+    volatile int memory = 100;
+    SemPtr sem = SemPtr(new Sem((Address)&memory, 4, &memio));
+    sem->setScanType("int32");
+    sem->setLockInterval(1);
+    sem->lock(true);
+
+    Freezer freezer(&memio);
+    freezer.setWriteOnlyIfChanged(true);
+    freezer.start();
+    freezer.add(sem);
+
+    this_thread::sleep_for(chrono::milliseconds(10));
+    TS_ASSERT_EQUALS(sem->getCorrections(), 0);
+
+    memory = 20;
+    waitUntil([&memory]() { return memory == 100; });
+    TS_ASSERT_EQUALS(memory, 100);
+    TS_ASSERT_EQUALS(sem->getCorrections(), 1);
+
+    freezer.stop();
+  }
+
+  void testWriteNow() {
+    MemIO memio;
+    int memory[] = { 1, 2 };
+    SemPtr first = SemPtr(new Sem((Address)&memory[0], 4, &memio));
+    first->setScanType("int32");
+    first->setLockedValue("10");
+    SemPtr second = SemPtr(new Sem((Address)&memory[1], 4, &memio));
+    second->setScanType("int32");
+    second->setLockedValue("20");
+
+    Freezer freezer(&memio);
+    freezer.writeNow({ first, second });
+    TS_ASSERT_EQUALS(memory[0], 10);
+    TS_ASSERT_EQUALS(memory[1], 20);
+  }
+
+private:
+  template<typename Predicate>
+  void waitUntil(Predicate predicate) {
+    for (int i = 0; i < 1000 && !predicate(); i++) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+};
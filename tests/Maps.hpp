@@ -102,4 +102,30 @@ public:
     TS_ASSERT_EQUALS(maps[1].first, 30);
     TS_ASSERT_EQUALS(maps[1].second, 40);
   }
+
+  void testExclude() {
+    Maps maps;
+    maps.push(AddressPair(10, 20));
+    maps.push(AddressPair(30, 40));
+
+    AddressPairs ranges = { AddressPair(12, 14), AddressPair(18, 32), AddressPair(38, 40) };
+    maps.exclude(ranges);
+    TS_ASSERT_EQUALS(maps.size(), 3);
+    TS_ASSERT_EQUALS(maps[0], AddressPair(10, 12));
+    TS_ASSERT_EQUALS(maps[1], AddressPair(14, 18));
+    TS_ASSERT_EQUALS(maps[2], AddressPair(32, 38));
+  }
+
+  void testContains() {
+    Maps maps;
+    maps.push(AddressPair(30, 40));
+    maps.push(AddressPair(10, 20));
+    maps.sort();
+    TS_ASSERT_EQUALS(maps.contains(5), false);
+    TS_ASSERT_EQUALS(maps.contains(10), true);
+    TS_ASSERT_EQUALS(maps.contains(19), true);
+    TS_ASSERT_EQUALS(maps.contains(20), false);
+    TS_ASSERT_EQUALS(maps.contains(35), true);
+    TS_ASSERT_EQUALS(maps.contains(40), false);
+  }
 };
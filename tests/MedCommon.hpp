@@ -32,4 +32,43 @@ public:
 
     delete[] buffer;
   }
+
+  void testModuleOffset() {
+    string maps =
+      "55d0c0a00000-55d0c0a01000 r--p 00000000 08:01 1234   /usr/bin/testfile\n"
+      "55d0c0a01000-55d0c0a02000 r-xp 00001000 08:01 1234   /usr/bin/testfile\n"
+      "55d0c1000000-55d0c1021000 rw-p 00000000 00:00 0      [heap]\n"
+      "7f0000000000-7f0000028000 r--p 00000000 08:01 5678   /usr/lib/libc.so.6\n";
+    vector<Module> modules = parseModules(maps);
+    TS_ASSERT_EQUALS(modules.size(), 2);
+    TS_ASSERT_EQUALS(modules[0].end, 0x55d0c0a02000);
+
+    TS_ASSERT_EQUALS(addressToModuleOffset(modules, 0x55d0c0a011c1), "testfile+0x11c1");
+    TS_ASSERT_EQUALS(addressToModuleOffset(modules, 0x7f0000000010), "libc.so.6+0x10");
+    TS_ASSERT_EQUALS(addressToModuleOffset(modules, 0x55d0c1000010), "0x55d0c1000010");
+  }
+
+  void testRelocateAddress() {
+    vector<Module> from = {
+      Module { "/usr/bin/game", 0x55d0c0a00000, 0x55d0c0a20000 },
+      Module { "/usr/lib/libc.so.6", 0x7f0000000000, 0x7f0000028000 }
+    };
+    vector<Module> to = {
+      Module { "/usr/lib/libc.so.6", 0x7f1000000000, 0x7f1000028000 },
+      Module { "/usr/bin/game", 0x5600c0a00000, 0x5600c0a20000 }
+    };
+    TS_ASSERT_EQUALS(relocateAddress(0x55d0c0a011c0, from, to), 0x5600c0a011c0);
+    TS_ASSERT_EQUALS(relocateAddress(0x7f0000000010, from, to), 0x7f1000000010);
+    TS_ASSERT_EQUALS(relocateAddress(0x55d0c1000010, from, to), 0x55d0c1000010); // Heap
+
+    bool relocated;
+    relocateAddress(0x55d0c0a011c0, from, to, &relocated);
+    TS_ASSERT(relocated);
+    relocateAddress(0x55d0c1000010, from, to, &relocated);
+    TS_ASSERT(!relocated);
+
+    to.pop_back();
+    TS_ASSERT_EQUALS(relocateAddress(0x55d0c0a011c0, from, to, &relocated), 0x55d0c0a011c0); // Not loaded yet
+    TS_ASSERT(!relocated);
+  }
 };
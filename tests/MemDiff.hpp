@@ -0,0 +1,65 @@
+#include <cstring>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/MemDiff.hpp"
+#include "mem/MemIO.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+class TestMemDiff : public CxxTest::TestSuite {
+public:
+  void testDiff() {
+    Byte before[200];
+    Byte after[200];
+    memset(before, 1, sizeof(before));
+    memcpy(after, before, sizeof(after));
+    after[3] = 2;
+    after[4] = 2;
+    after[70] = 2;
+    after[73] = 2;
+    after[199] = 2;
+
+    auto ranges = MemDiff::diff(1000, before, after, sizeof(before));
+    TS_ASSERT_EQUALS(ranges.size(), 4);
+    TS_ASSERT_EQUALS(ranges[0].address, 1003);
+    TS_ASSERT_EQUALS(ranges[0].size, 2);
+    TS_ASSERT_EQUALS(ranges[1].address, 1070);
+    TS_ASSERT_EQUALS(ranges[3].address, 1199);
+
+    ranges = MemDiff::diff(1000, before, after, sizeof(before), 2);
+    TS_ASSERT_EQUALS(ranges.size(), 3);
+    TS_ASSERT_EQUALS(ranges[1].address, 1070);
+    TS_ASSERT_EQUALS(ranges[1].size, 4);
+  }
+
+  void testCompareLive() {
+    int memory[1024] = {0};
+    memory[10] = 100;
+
+    MemIO memio;
+    memio.setPid(getpid());
+    MemDiff memDiff(&memio);
+    auto before = memDiff.take((Address)memory, sizeof(memory));
+
+    memory[10] = 0x10203;
+    memory[500] = -1;
+    MemSnapshot after;
+    auto ranges = memDiff.compareLive(before, after);
+    TS_ASSERT_EQUALS(ranges.size(), 2);
+    TS_ASSERT_EQUALS(ranges[0].address, (Address)&memory[10]);
+    TS_ASSERT_EQUALS(ranges[0].size, 3);
+
+    auto values = MemDiff::interpret(before, after, ranges[0], "int32");
+    TS_ASSERT_EQUALS(values.size(), 1);
+    TS_ASSERT_EQUALS(values[0].before, "100");
+    TS_ASSERT_EQUALS(values[0].after, "66051");
+
+    values = MemDiff::interpret(before, after, ranges[1], "int16");
+    TS_ASSERT_EQUALS(values.size(), 2);
+    TS_ASSERT_EQUALS(values[1].after, "65535");
+
+    TS_ASSERT_THROWS(memDiff.compare(before, memDiff.take((Address)memory, 16)), MedException&);
+  }
+};
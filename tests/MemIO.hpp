@@ -1,5 +1,10 @@
+#include <atomic>
 #include <string>
 #include <cstdio>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <cxxtest/TestSuite.h>
 
 #include "mem/MemIO.hpp"
@@ -28,4 +33,80 @@ public:
     TS_ASSERT_EQUALS(ptr1[1], 0x68);
     TS_ASSERT_EQUALS(ptr1[2], 0x66);
   }
+
+  void testReadToBuffer() {
+    unsigned char ptr1[] = { 0x64, 0x65, 0x66 };
+    unsigned char buffer[2];
+    MemIO memIO;
+    TS_ASSERT_EQUALS(memIO.read((Address)(ptr1 + 1), buffer, 2), 2);
+    TS_ASSERT_EQUALS(buffer[0], 0x65);
+    TS_ASSERT_EQUALS(buffer[1], 0x66);
+  }
+
+  void testWriteRanges() {
+    unsigned char memory[] = { 0x64, 0x65, 0x66, 0x67 };
+    unsigned char first = 0x01;
+    unsigned char second[] = { 0x02, 0x03 };
+    MemIO memIO;
+    vector<MemRange> ranges {
+      MemRange { (Address)memory, 1, &first, false },
+      MemRange { (Address)(memory + 2), 2, second, false }
+    };
+    TS_ASSERT_EQUALS(memIO.write(ranges), 2);
+    TS_ASSERT_EQUALS(memory[0], 0x01);
+    TS_ASSERT_EQUALS(memory[1], 0x65);
+    TS_ASSERT_EQUALS(memory[3], 0x03);
+    TS_ASSERT(ranges[1].valid);
+  }
+
+  void testSetPidWhileReading() {
+    static int value;
+    value = 1;
+    pid_t first = fork();
+    if (first == 0) {
+      pause();
+      _exit(0);
+    }
+    value = 2;
+    pid_t second = fork();
+    if (second == 0) {
+      pause();
+      _exit(0);
+    }
+
+    MemIO memIO;
+    memIO.setPid(first);
+    std::atomic<bool> switched(false);
+    std::atomic<int> afterSwitch(0);
+    std::atomic<bool> done(false);
+    std::thread reader([&] {
+        while (!done) {
+          bool wasSwitched = switched;
+          int buffer = 0;
+          if (memIO.read((Address)&value, (Byte*)&buffer, sizeof(buffer)) == sizeof(buffer) && wasSwitched) {
+            afterSwitch = buffer;
+            if (buffer != 2) {
+              break;
+            }
+          }
+        }
+      });
+    for (int i = 0; i < 100; i++) {
+      memIO.setPid(i % 2 ? first : second);
+    }
+    memIO.setPid(second);
+    switched = true;
+    while (afterSwitch == 0) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    done = true;
+    reader.join();
+    TS_ASSERT_EQUALS(afterSwitch, 2);
+
+    kill(first, SIGKILL);
+    kill(second, SIGKILL);
+    waitpid(first, NULL, 0);
+    waitpid(second, NULL, 0);
+  }
 };
@@ -0,0 +1,43 @@
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/MemList.hpp"
+#include "mem/Pem.hpp"
+
+using namespace std;
+
+class TestMemList : public CxxTest::TestSuite {
+public:
+  void testGetValuesOfTwoProcesses() {
+    int memory[] = {100, 300};
+    pid_t child = fork();
+    if (child == 0) {
+      pause();
+      _exit(0);
+    }
+    memory[0] = 200; // The child keeps 100
+
+    MemIO memio;
+    MemIO childMemIO;
+    childMemIO.setPid(child);
+    vector<MemPtr> mems = {
+      PemPtr(new Pem((Address)&memory[0], 4, &childMemIO)),
+      PemPtr(new Pem((Address)&memory[0], 4, &memio)),
+      PemPtr(new Pem((Address)&memory[1], 4, &childMemIO))
+    };
+    for (auto& mem : mems) {
+      static_pointer_cast<Pem>(mem)->setScanType("int32");
+    }
+    MemList list(mems);
+    vector<string> values = list.getValues();
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+
+    TS_ASSERT_EQUALS(values.size(), 3);
+    TS_ASSERT_EQUALS(values[0], "100");
+    TS_ASSERT_EQUALS(values[1], "200");
+    TS_ASSERT_EQUALS(values[2], "300");
+  }
+};
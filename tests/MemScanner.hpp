@@ -1,10 +1,16 @@
 #include <string>
 #include <cstdio>
 #include <iostream>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <unistd.h>
 #include <cxxtest/TestSuite.h>
 
 #include "mem/MemScanner.hpp"
 #include "med/Operands.hpp"
+#include "mem/Pem.hpp"
+#include "mem/MemList.hpp"
 
 using namespace std;
 
@@ -44,6 +50,111 @@ public:
     TS_ASSERT_EQUALS(list.size(), 1);
   }
 
+  void testFilterByScanCommand() {
+    MemScanner scanner;
+    vector<int> memory(20000, 7);
+    memory[3] = 9;
+    memory[15000] = 9;
+
+    auto buffer = ScanParser::valueToBytes("7", "int32");
+    Operands operands(std::vector<SizedBytes>{ buffer });
+    auto list = scanner.scanInner(operands, buffer.getSize(), (Address)memory.data(), 4 * memory.size(), "int32", ScanParser::OpType::Eq);
+    std::reverse(list.begin(), list.end());
+
+    memory[3] = 7;
+    memory[19999] = 8;
+    ScanCommand scanCommand("7", "int32");
+    list = scanner.filter(list, scanCommand);
+    TS_ASSERT_EQUALS(list.size(), 19997);
+    TS_ASSERT_EQUALS(list[0]->getAddress(), (Address)memory.data());
+    TS_ASSERT_EQUALS(list[3]->getAddress(), (Address)&memory[4]);
+    TS_ASSERT_EQUALS(static_pointer_cast<Pem>(list[0])->recallValuePtr()[0], 7);
+  }
+
+  void testFilterStats() {
+    MemScanner scanner;
+    vector<int> memory(10000, 7);
+
+    auto buffer = ScanParser::valueToBytes("7", "int32");
+    Operands operands(std::vector<SizedBytes>{ buffer });
+    auto list = scanner.scanInner(operands, buffer.getSize(), (Address)memory.data(), 4 * memory.size(), "int32", ScanParser::OpType::Eq);
+
+    memory[100] = 8;
+    ScanCommand scanCommand("7", "int32");
+    list = scanner.filter(list, scanCommand);
+
+    ScanStats stats = scanner.getStats();
+    TS_ASSERT_EQUALS(stats.operation, "filter");
+    TS_ASSERT_EQUALS(stats.results, list.size());
+    TS_ASSERT_EQUALS(stats.tasks, 3);
+    TS_ASSERT(stats.bytesRead >= 4 * list.size());
+    TS_ASSERT(stats.wallTime > 0);
+    TS_ASSERT(stats.threadUtilization <= 1.0);
+  }
+
+  void testFilterProgress() {
+    MemScanner scanner;
+    vector<int> memory(10000, 7);
+
+    auto buffer = ScanParser::valueToBytes("7", "int32");
+    Operands operands(std::vector<SizedBytes>{ buffer });
+    auto list = scanner.scanInner(operands, buffer.getSize(), (Address)memory.data(), 4 * memory.size(), "int32", ScanParser::OpType::Eq);
+
+    ScanProgressPtr progress(new ScanProgress());
+    scanner.setProgress(progress);
+    ScanCommand scanCommand("7", "int32");
+    auto filtered = scanner.filter(list, scanCommand);
+
+    TS_ASSERT_EQUALS(filtered.size(), 10000);
+    TS_ASSERT_EQUALS(progress->getBytesDone(), 4 * 10000);
+    TS_ASSERT_EQUALS(progress->getBytesTotal(), 4 * 10000);
+    TS_ASSERT_EQUALS(progress->getRegionsDone(), 3);
+    TS_ASSERT_EQUALS(progress->getMatches(), 10000);
+    TS_ASSERT_EQUALS(progress->takePartial().size(), 10000);
+    TS_ASSERT_EQUALS(progress->takePartial().size(), 0);
+
+    progress = ScanProgressPtr(new ScanProgress());
+    progress->cancel();
+    scanner.setProgress(progress);
+    memory[0] = 8;
+    filtered = scanner.filter(list, scanCommand);
+    TS_ASSERT_EQUALS(filtered.size(), 10000); // Passed through unchecked
+    TS_ASSERT_EQUALS(filtered[0]->getAddress(), (Address)memory.data());
+    TS_ASSERT_EQUALS(progress->getRegionsDone(), 0);
+    TS_ASSERT_EQUALS(progress->getMatches(), 0);
+  }
+
+  void testCancelledFilterKeepsRememberedValues() {
+    MemScanner scanner;
+    vector<int> memory(400000, 7);
+    auto buffer = ScanParser::valueToBytes("7", "int32");
+    Operands operands(std::vector<SizedBytes>{ buffer });
+    auto list = scanner.scanInner(operands, buffer.getSize(), (Address)memory.data(), 4 * memory.size(), "int32", ScanParser::OpType::Eq);
+    std::fill(memory.begin(), memory.end(), 8);
+
+    // Cancel once some chunks are filtered
+    ScanProgressPtr progress(new ScanProgress());
+    scanner.setProgress(progress);
+    vector<MemPtr> filtered;
+    std::thread filtering([&]() {
+        filtered = scanner.filterUnknown(list, "int32", ScanParser::OpType::Neq, false);
+      });
+    while (progress->getRegionsDone() == 0) {
+      std::this_thread::yield();
+    }
+    progress->cancel();
+    filtering.join();
+
+    TS_ASSERT_EQUALS(filtered.size(), list.size());
+    if (progress->getRegionsDone() < progress->getRegionsTotal()) { // Otherwise finished before the cancel
+      size_t changed = 0;
+      for (auto& mem : list) {
+        changed += static_pointer_cast<Pem>(mem)->recallValue("int32") != "7";
+      }
+      TS_ASSERT_EQUALS(changed, 0);
+    }
+  }
+
   void testGreater() {
     MemScanner scanner;
     int memory[] = {100, 200, 100};
@@ -94,6 +205,58 @@ public:
     TS_ASSERT_EQUALS(list[0]->getAddress(), (Address)(&memory[2]));
   }
 
+  void testFilterDelta() {
+    MemScanner scanner;
+    int memory[] = {100, 200, 100};
+
+    auto buffer = ScanParser::valueToBytes("100", "int32");
+    size_t size = buffer.getSize();
+    Operands operands(std::vector<SizedBytes>{ buffer });
+
+    auto list = scanner.scanInner(operands, size, (Address)memory, 4 * 3, "int32", ScanParser::OpType::Eq);
+
+    memory[0] = 105;
+    memory[2] = 98;
+    DeltaMatcher increased("+= 5", "int32");
+    auto result = scanner.filterDeltaInner(list, increased);
+    TS_ASSERT_EQUALS(result.size(), 1);
+    TS_ASSERT_EQUALS(result[0]->getAddress(), (Address)memory);
+
+    DeltaMatcher decreased("-= 1 3", "int32");
+    result = scanner.filterDeltaInner(list, decreased);
+    TS_ASSERT_EQUALS(result.size(), 1);
+    TS_ASSERT_EQUALS(result[0]->getAddress(), (Address)(&memory[2]));
+  }
+
+  void testScanRecords() {
+    const size_t stride = 16;
+    vector<int32_t> memory(200 * 1024 / sizeof(int32_t), 0);
+    Byte* base = (Byte*)memory.data();
+    auto setRecord = [base](size_t offset, int32_t id, float value) {
+      memcpy(base + offset, &id, sizeof(id));
+      memcpy(base + offset + 8, &value, sizeof(value));
+    };
+    size_t arrayStart = 64 * 1024 - stride * 5; // Across the windows
+    for (size_t i = 0; i < 20; i++) {
+      setRecord(arrayStart + i * stride, i + 1, 1.5);
+    }
+    for (size_t i = 0; i < 5; i++) { // Too short
+      setRecord(1024 + i * stride, i + 1, 1.5);
+    }
+
+    MemScanner scanner(getpid());
+    scanner.setScopeStart((Address)base);
+    scanner.setScopeEnd((Address)base + memory.size() * sizeof(int32_t));
+    RecordMatcher matcher("0x0 int32 <> 1 999; 0x8 float32 > 0", stride, 10);
+    auto list = scanner.scanRecords(matcher);
+    list = MemList::sortByAddress(list);
+
+    TS_ASSERT_EQUALS(list.size(), 20);
+    TS_ASSERT_EQUALS(list[0]->getAddress(), (Address)(base + arrayStart));
+    TS_ASSERT_EQUALS(list[19]->getAddress(), (Address)(base + arrayStart + 19 * stride));
+    TS_ASSERT_EQUALS(static_pointer_cast<Pem>(list[19])->recallValue("int32"), "20");
+  }
+
   void testScanUnknown() {
     MemScanner scanner;
     int memory[] = {100, 200, 100};
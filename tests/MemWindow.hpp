@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/MemWindow.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+class TestMemWindow : public CxxTest::TestSuite {
+public:
+  void testUpdate() {
+    const size_t pageSize = MemWindow::DEFAULT_PAGE_SIZE;
+    Byte* memory = (Byte*)aligned_alloc(pageSize, pageSize * 4);
+    memset(memory, 7, pageSize * 4);
+    Address base = (Address)memory;
+
+    MemIO memio;
+    memio.setPid(getpid());
+    MemWindow window(&memio);
+    window.setPrefetch(1);
+    window.setView(base + pageSize, pageSize);
+    TS_ASSERT_EQUALS(window.update(), 3);
+    TS_ASSERT_EQUALS(window.getNumOfPages(), 3);
+
+    Byte buffer[8];
+    TS_ASSERT(window.get(base + pageSize * 2 - 4, buffer, 8)); // Across the pages
+    TS_ASSERT_EQUALS(buffer[0], 7);
+    TS_ASSERT_EQUALS(window.getAge(base + pageSize), MemWindow::NEVER_CHANGED);
+    TS_ASSERT(!window.isReadable(base + pageSize * 3));
+
+    memory[pageSize + 10] = 9;
+    memory[0] = 9; // Prefetched, not read again
+    window.update();
+    TS_ASSERT(window.get(base + pageSize + 10, buffer, 1));
+    TS_ASSERT_EQUALS(buffer[0], 9);
+    TS_ASSERT_EQUALS(window.getAge(base + pageSize + 10), 0);
+    TS_ASSERT_EQUALS(window.getAge(base + pageSize + 11), MemWindow::NEVER_CHANGED);
+    TS_ASSERT(window.get(base, buffer, 1));
+    TS_ASSERT_EQUALS(buffer[0], 7);
+
+    window.update();
+    TS_ASSERT_EQUALS(window.getAge(base + pageSize + 10), 1);
+
+    // Scrolled, the far pages are evicted
+    window.setMaxPages(3);
+    window.setView(base + pageSize * 3, pageSize);
+    window.update();
+    TS_ASSERT(window.getNumOfPages() <= 4);
+    TS_ASSERT(window.isReadable(base + pageSize * 3));
+    TS_ASSERT(!window.isReadable(base));
+
+    free(memory);
+  }
+};
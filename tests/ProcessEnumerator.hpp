@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "med/ProcessEnumerator.hpp"
+
+using namespace std;
+
+class TestProcessEnumerator : public CxxTest::TestSuite {
+public:
+  void testParseStat() {
+    Process process;
+    string stat = "1234 (my (game) x) S 1000 1234 1234 0 -1 4194560 100 0 0 0 "
+      "10 5 0 0 20 0 4 0 98765 123456789 2560 18446744073709551615";
+    TS_ASSERT(ProcessEnumerator::parseStat(stat, process));
+    TS_ASSERT_EQUALS(process.comm, "my (game) x");
+    TS_ASSERT_EQUALS(process.ppid, 1000);
+    TS_ASSERT_EQUALS(process.startTime, 98765ULL);
+    TS_ASSERT_EQUALS(process.rss, 2560 * (size_t)sysconf(_SC_PAGESIZE));
+
+    TS_ASSERT(!ProcessEnumerator::parseStat("1234 (truncated", process));
+  }
+
+  void testRefresh() {
+    ProcessEnumerator enumerator;
+    enumerator.refresh();
+    Process self = findSelf(enumerator.getProcesses());
+    TS_ASSERT_EQUALS(self.ppid, getppid());
+    TS_ASSERT(self.rss > 0);
+    TS_ASSERT(self.cmdline.length() > 0);
+
+    char exe[4096];
+    ssize_t size = readlink("/proc/self/exe", exe, sizeof(exe));
+    TS_ASSERT_EQUALS(self.exe, string(exe, size));
+
+    // Refreshed from the cache
+    enumerator.refresh();
+    Process cached = findSelf(enumerator.getProcesses());
+    TS_ASSERT_EQUALS(cached.startTime, self.startTime);
+    TS_ASSERT_EQUALS(cached.exe, self.exe);
+  }
+
+  void testFilter() {
+    ProcessEnumerator enumerator;
+    enumerator.refresh();
+    Process self = findSelf(enumerator.getProcesses());
+
+    TS_ASSERT_EQUALS(findSelf(enumerator.filter(self.comm)).pid, self.pid);
+    TS_ASSERT_EQUALS(findSelf(enumerator.filter(self.comm, self.rss * 1024)).pid, "");
+
+    vector<Process> largest = enumerator.getLargest(2);
+    TS_ASSERT_EQUALS(largest.size(), 2);
+    TS_ASSERT(largest[0].rss >= largest[1].rss);
+    TS_ASSERT(largest[0].rss >= self.rss);
+  }
+
+  void testTree() {
+    pid_t child = fork();
+    if (child == 0) {
+      pause();
+      _exit(0);
+    }
+    ProcessEnumerator enumerator;
+    enumerator.refresh();
+    vector<pid_t> tree = enumerator.getTree(getpid());
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+
+    TS_ASSERT_EQUALS(tree[0], getpid());
+    TS_ASSERT(std::find(tree.begin(), tree.end(), child) != tree.end());
+  }
+
+private:
+  Process findSelf(const vector<Process>& processes) {
+    for (auto& process : processes) {
+      if (process.pid == to_string(getpid())) {
+        return process;
+      }
+    }
+    return Process();
+  }
+};
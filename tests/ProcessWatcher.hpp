@@ -0,0 +1,112 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "med/ProcessWatcher.hpp"
+
+using namespace std;
+
+class TestProcessWatcher : public CxxTest::TestSuite {
+public:
+  void testIsNewInstance() {
+    Process process;
+    process.pid = "100";
+    process.startTime = 5000;
+    process.exe = "/usr/bin/game";
+    process.cmdline = "/usr/bin/game --fullscreen";
+
+    Process same = process;
+    TS_ASSERT(!ProcessWatcher::isNewInstance(process, same));
+
+    Process restarted = process;
+    restarted.pid = "200";
+    restarted.startTime = 9000;
+    TS_ASSERT(ProcessWatcher::isNewInstance(process, restarted));
+
+    Process reused = process; // Same pid, another process
+    reused.startTime = 9000;
+    reused.exe = "/usr/bin/other";
+    TS_ASSERT(!ProcessWatcher::isNewInstance(process, reused));
+
+    Process sibling = process; // Another instance, running before the process
+    sibling.pid = "50";
+    sibling.startTime = 4000;
+    TS_ASSERT(!ProcessWatcher::isNewInstance(process, sibling));
+
+    // The exe is unknown without permission, fall back to the cmdline
+    process.exe = "";
+    restarted.exe = "";
+    TS_ASSERT(ProcessWatcher::isNewInstance(process, restarted));
+    restarted.cmdline = "/usr/bin/game --windowed";
+    TS_ASSERT(!ProcessWatcher::isNewInstance(process, restarted));
+  }
+
+  void testExit() {
+    pid_t child = fork();
+    if (child == 0) {
+      pause();
+      _exit(0);
+    }
+
+    ProcessEnumerator enumerator;
+    enumerator.refresh();
+    Process process;
+    for (auto& candidate : enumerator.getProcesses()) {
+      if (candidate.pid == to_string(child)) {
+        process = candidate;
+      }
+    }
+    TS_ASSERT_EQUALS(process.pid, to_string(child));
+
+    ProcessWatcher watcher;
+    watcher.watch(process);
+    this_thread::sleep_for(chrono::milliseconds(ProcessWatcher::WATCH_INTERVAL * 2));
+    TS_ASSERT(!watcher.isExited());
+
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    this_thread::sleep_for(chrono::milliseconds(ProcessWatcher::WATCH_INTERVAL * 3));
+    TS_ASSERT(watcher.isExited());
+    watcher.stop();
+  }
+
+  void testSiblingNotRestart() {
+    pid_t sibling = fork();
+    if (sibling == 0) {
+      pause();
+      _exit(0);
+    }
+    this_thread::sleep_for(chrono::milliseconds(20)); // The start time is in clock ticks
+    pid_t child = fork();
+    if (child == 0) {
+      pause();
+      _exit(0);
+    }
+
+    ProcessEnumerator enumerator;
+    enumerator.refresh();
+    Process process;
+    for (auto& candidate : enumerator.getProcesses()) {
+      if (candidate.pid == to_string(child)) {
+        process = candidate;
+      }
+    }
+
+    ProcessWatcher watcher;
+    watcher.watch(process);
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+    this_thread::sleep_for(chrono::milliseconds(ProcessWatcher::WATCH_INTERVAL * 3 + ProcessWatcher::RESTART_SETTLE_TIME));
+
+    Process restarted;
+    vector<Module> modules;
+    TS_ASSERT(!watcher.takeRestart(restarted, modules));
+    watcher.stop();
+    kill(sibling, SIGKILL);
+    waitpid(sibling, NULL, 0);
+  }
+};
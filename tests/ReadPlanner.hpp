@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#include "mem/ReadPlanner.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+class TestReadPlanner : public CxxTest::TestSuite {
+public:
+  void testMergeNearby() {
+    int memory[1024] = {0};
+    memory[0] = 10;
+    memory[2] = 20;
+    memory[1000] = 30;
+
+    MemIO memio;
+    ReadPlanner planner(64);
+    planner.add((Address)&memory[1000], 4);
+    planner.add((Address)&memory[0], 4);
+    planner.add((Address)&memory[2], 4);
+
+    TS_ASSERT_EQUALS(planner.read(&memio), 3);
+    TS_ASSERT_EQUALS(planner.getRanges().size(), 2);
+    TS_ASSERT_EQUALS(planner.getRanges()[0].size, 12);
+    TS_ASSERT_EQUALS(planner.getBytesNeeded(), 12);
+    TS_ASSERT_EQUALS(planner.getBytesPlanned(), 16);
+
+    TS_ASSERT_EQUALS(*(int*)planner.getData(0), 30);
+    TS_ASSERT_EQUALS(*(int*)planner.getData(1), 10);
+    TS_ASSERT_EQUALS(*(int*)planner.getData(2), 20);
+  }
+
+  void testOverlapping() {
+    char memory[] = "abcdefgh";
+    MemIO memio;
+    ReadPlanner planner(0);
+    planner.add((Address)memory, 4);
+    planner.add((Address)(memory + 2), 4);
+    planner.add((Address)(memory + 7), 1);
+
+    planner.read(&memio);
+    TS_ASSERT_EQUALS(planner.getRanges().size(), 2);
+    TS_ASSERT_EQUALS(string((char*)planner.getData(1), 4), "cdef");
+    TS_ASSERT_EQUALS(*planner.getData(2), 'h');
+  }
+
+  void testStats() {
+    int memory[] = { 1, 2, 3 };
+    MemIO memio;
+    ReadPlanner planner;
+    planner.add((Address)&memory[0], 4);
+    planner.add((Address)&memory[2], 4);
+    planner.read(&memio);
+
+    MemIOStats stats = memio.getStats();
+    TS_ASSERT_EQUALS(stats.bytesNeeded, 8);
+    TS_ASSERT_EQUALS(stats.bytesRead, 12);
+  }
+};
@@ -0,0 +1,64 @@
+#include <string>
+#include <cxxtest/TestSuite.h>
+
+#include "med/RecordMatcher.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+struct TestRecord {
+  int32_t id;
+  int32_t padding;
+  float value;
+  int32_t count;
+};
+
+class TestRecordMatcher : public CxxTest::TestSuite {
+public:
+  void testMatch() {
+    RecordMatcher matcher("0x0 int32 <> 1 999; 0x8 float32 > 0", sizeof(TestRecord), 10);
+    TestRecord record = { 5, 0, 1.5, 0 };
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&record), true);
+    record.value = -1;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&record), false);
+    record.value = 1;
+    record.id = 1000;
+    TS_ASSERT_EQUALS(matcher.match((Byte*)&record), false);
+
+    TS_ASSERT_EQUALS(matcher.getSpan(), 12);
+    TS_ASSERT_EQUALS(matcher.getAlignment(), 4);
+    TS_ASSERT_EQUALS(matcher.getScanType(), SCAN_TYPE_INT_32);
+  }
+
+  void testScanTypeOfRecordStart() {
+    RecordMatcher reordered("0x8 float32 > 0; 0x0 int16 <> 1 999", 16, 1);
+    TS_ASSERT_EQUALS(reordered.getScanType(), SCAN_TYPE_INT_16);
+
+    RecordMatcher noStart("0x8 float32 > 0", 16, 1);
+    TS_ASSERT_EQUALS(noStart.getScanType(), SCAN_TYPE_INT_8);
+  }
+
+  void testMatchBlock() {
+    TestRecord records[] = {
+      { 1, 0, 1, 0 },
+      { 2, 0, 0, 0 },
+      { -1, 0, 1, 0 },
+      { 3, 0, 2, 7 }
+    };
+    RecordMatcher matcher("0x0 int32 >= 1; 0x8 float32 > 0", sizeof(TestRecord), 1);
+    Byte mask[4];
+    TS_ASSERT_EQUALS(matcher.matchBlock((Byte*)records, 4, sizeof(TestRecord), mask), 2);
+    TS_ASSERT_EQUALS(mask[0], 1);
+    TS_ASSERT_EQUALS(mask[1], 0);
+    TS_ASSERT_EQUALS(mask[2], 0);
+    TS_ASSERT_EQUALS(mask[3], 1);
+  }
+
+  void testInvalid() {
+    TS_ASSERT_THROWS(RecordMatcher("", 16, 10), MedException&);
+    TS_ASSERT_THROWS(RecordMatcher("0x0 int32", 16, 10), MedException&);
+    TS_ASSERT_THROWS(RecordMatcher("0x0 string = 1", 16, 10), MedException&);
+    TS_ASSERT_THROWS(RecordMatcher("0x0 int32 += 1", 16, 10), MedException&);
+    TS_ASSERT_THROWS(RecordMatcher("0x10 int32 = 1", 16, 10), MedException&);
+  }
+};
@@ -34,6 +34,9 @@ public:
     TS_ASSERT_EQUALS(ScanParser::stringToOpType(">="), ScanParser::Ge);
     TS_ASSERT_EQUALS(ScanParser::stringToOpType("<="), ScanParser::Le);
     TS_ASSERT_EQUALS(ScanParser::stringToOpType("<>"), ScanParser::Within);
+    TS_ASSERT_EQUALS(ScanParser::stringToOpType("~u"), ScanParser::AroundUlp);
+    TS_ASSERT_EQUALS(ScanParser::stringToOpType("~r"), ScanParser::Rounded);
+    TS_ASSERT_EQUALS(ScanParser::stringToOpType("~t"), ScanParser::Truncated);
   }
 
   void testGetOp() {
@@ -67,6 +70,13 @@ public:
     TS_ASSERT_EQUALS(ScanParser::getOp(" <> 1234 5432 "), "<>");
 
     TS_ASSERT_EQUALS(ScanParser::getOp(" < "), "<");
+
+    TS_ASSERT_EQUALS(ScanParser::getOp("~u 12.5 4"), "~u");
+    TS_ASSERT_EQUALS(ScanParser::getValue("~r 12"), "12");
+    TS_ASSERT_EQUALS(ScanParser::getOp("+= 5"), "+=");
+    TS_ASSERT_EQUALS(ScanParser::getOp("-= 2 10"), "-=");
+    TS_ASSERT_EQUALS(ScanParser::getOp("-5"), "");
+    TS_ASSERT_EQUALS(ScanParser::getOpType("%< 10"), ScanParser::ChangedByPercent);
   }
 
   void testGetValue() {
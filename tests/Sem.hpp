@@ -0,0 +1,43 @@
+#include <string>
+#include <cxxtest/TestSuite.h>
+
+#include "med/MedTypes.hpp"
+#include "mem/Sem.hpp"
+
+using namespace std;
+
+class TestSem : public CxxTest::TestSuite {
+public:
+  void testLockValue() {
+    MemIO* memio = new MemIO();
+
+    int memory = 100;
+    SemPtr sem = SemPtr(new Sem((Address)&memory, 4, memio));
+    sem->setScanType("int32");
+    sem->lock(true);
+    TS_ASSERT_EQUALS(sem->getLockedValue(), "100");
+
+    memory = 20;
+    sem->lockValue();
+    TS_ASSERT_EQUALS(memory, 100);
+
+    delete memio;
+  }
+
+  void testLockedBytesFollowScanType() {
+    MemIO* memio = new MemIO();
+
+    int memory = 0;
+    SemPtr sem = SemPtr(new Sem((Address)&memory, 4, memio));
+    sem->setScanType("int32");
+    sem->setLockedValue("300");
+    TS_ASSERT_EQUALS(sem->getLockedBytes().getSize(), 4);
+
+    sem->setScanType("int16");
+    SizedBytes bytes = sem->getLockedBytes();
+    TS_ASSERT_EQUALS(bytes.getSize(), 2);
+    TS_ASSERT_EQUALS(*(uint16_t*)bytes.getBytes(), 300);
+
+    delete memio;
+  }
+};
@@ -0,0 +1,83 @@
+#include <cstring>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/StructTemplate.hpp"
+#include "mem/MemIO.hpp"
+#include "med/MedException.hpp"
+
+using namespace std;
+
+struct TestOwner {
+  int64_t id;
+  int32_t level;
+};
+
+struct TestEntity {
+  int32_t hp;
+  float pos[3];
+  char name[16];
+  TestOwner* owner;
+};
+
+class TestStructTemplate : public CxxTest::TestSuite {
+public:
+  void testCompile() {
+    StructTemplate tmpl(
+      "# Entity\n"
+      "hp    0x0  int32\n"
+      "pos   0x4  float32[3]\n"
+      "name  0x10 string[16]\n"
+      "owner 0x20 ptr64 {\n"
+      "  level 0x8 int32\n"
+      "}\n");
+    auto names = tmpl.getFieldNames();
+    TS_ASSERT_EQUALS(tmpl.getNumOfFields(), 7);
+    TS_ASSERT_EQUALS(names[1], "pos[0]");
+    TS_ASSERT_EQUALS(names[3], "pos[2]");
+    TS_ASSERT_EQUALS(names[6], "owner.level");
+    TS_ASSERT_EQUALS(tmpl.getFields()[3].offset, 0xc);
+    TS_ASSERT_EQUALS(tmpl.getFields()[4].size, 16);
+    TS_ASSERT_EQUALS(tmpl.getFields()[6].base, 5);
+
+    TS_ASSERT_THROWS(tmpl.compile("hp 0x0 int33"), MedException&);
+    TS_ASSERT_THROWS(tmpl.compile("name 0x0 string"), MedException&);
+    TS_ASSERT_THROWS(tmpl.compile("hp 0x0 int32 {\n}"), MedException&);
+    TS_ASSERT_THROWS(tmpl.compile("owner 0x0 ptr64 {\nlevel 0x8 int32"), MedException&);
+  }
+
+  void testRead() {
+    TestOwner owner = { 1, 42 };
+    TestEntity entities[3];
+    memset(entities, 0, sizeof(entities));
+    for (int i = 0; i < 3; i++) {
+      entities[i].hp = 100 + i;
+      entities[i].pos[1] = 1.5;
+      strcpy(entities[i].name, "entity");
+    }
+    entities[0].owner = &owner;
+
+    StructTemplate tmpl(
+      "hp    0x0  int32\n"
+      "pos   0x4  float32[3]\n"
+      "name  0x10 string[16]\n"
+      "owner 0x20 ptr64 {\n"
+      "  level 0x8 int32\n"
+      "}\n");
+
+    MemIO memio;
+    memio.setPid(getpid());
+    vector<Address> addresses;
+    for (int i = 0; i < 3; i++) {
+      addresses.push_back((Address)&entities[i]);
+    }
+    auto values = tmpl.read(&memio, addresses);
+    TS_ASSERT_EQUALS(values.size(), 3);
+    TS_ASSERT_EQUALS(values[0][0], "100");
+    TS_ASSERT_EQUALS(values[2][0], "102");
+    TS_ASSERT_EQUALS(values[1][2], "1.500000");
+    TS_ASSERT_EQUALS(values[1][4], "entity");
+    TS_ASSERT_EQUALS(values[0][6], "42");
+    TS_ASSERT_EQUALS(values[1][6], ""); // Null pointer
+  }
+};
@@ -66,4 +66,20 @@ public:
     SubCommand subCmd2(s);
     TS_ASSERT_EQUALS(subCmd2.op, ScanParser::OpType::Around);
   }
+
+  void test_floatArray() {
+    SubCommand subCmd("1.5,2.5", SCAN_TYPE_FLOAT_32);
+    TS_ASSERT_EQUALS(subCmd.getSize(), 8);
+    TS_ASSERT(!subCmd.isFloat()); // Compared by bytes over the full array
+
+    float memory[] = {1.5f, 2.5f};
+    TS_ASSERT(std::get<0>(subCmd.match((Byte*)memory)));
+    TS_ASSERT_EQUALS(std::get<1>(subCmd.match((Byte*)memory)), 8);
+    memory[1] = 9.0f;
+    TS_ASSERT(!std::get<0>(subCmd.match((Byte*)memory)));
+
+    SubCommand single("1.5", SCAN_TYPE_FLOAT_32);
+    TS_ASSERT(single.isFloat());
+    TS_ASSERT(std::get<0>(single.match((Byte*)memory)));
+  }
 };
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <signal.h>
+#include <cxxtest/TestSuite.h>
+#include <json/json.h>
+
+#include "med/MedCommon.hpp"
+#include "med/ScanCommand.hpp"
+#include "mem/Maps.hpp"
+#include "mem/MemScanner.hpp"
+
+using namespace std;
+
+// Path of the target, defined by the build
+#ifndef SYNTHETIC_TARGET
+#define SYNTHETIC_TARGET "./synthetic_target"
+#endif
+
+class TestSyntheticTarget : public CxxTest::TestSuite {
+public:
+  void testMappingsAreRegions() {
+    Json::Value truth = startTarget();
+    TS_ASSERT(truth["mappings_are_vmas"].asBool());
+    Maps maps = getMaps(truth["pid"].asInt());
+    TS_ASSERT_EQUALS(truth["mappings"].size(), 4);
+    for (auto& mapping : truth["mappings"]) {
+      AddressPair pair(hexToInt(mapping["start"].asString()), hexToInt(mapping["end"].asString()));
+      TS_ASSERT(maps.hasPair(pair));
+    }
+    stopTarget(truth);
+  }
+
+  void testScanPlantedValues() {
+    Json::Value truth = startTarget();
+    auto& mappings = truth["mappings"];
+    MemScanner scanner(truth["pid"].asInt());
+    scanner.setScopeStart(hexToInt(mappings[0]["start"].asString()));
+    scanner.setScopeEnd(hexToInt(mappings[mappings.size() - 1]["end"].asString()));
+    ScanCommand command(to_string(truth["value"].asInt()), truth["value_type"].asString());
+    vector<MemPtr> list = scanner.scan(command);
+
+    vector<Address> found;
+    for (auto& mem : list) {
+      found.push_back(mem->getAddress());
+    }
+    sort(found.begin(), found.end());
+
+    // Random fill may match as well, but every planted value must be found
+    TS_ASSERT_EQUALS(truth["values"].size(), 50);
+    for (auto& value : truth["values"]) {
+      TS_ASSERT(binary_search(found.begin(), found.end(), (Address)hexToInt(value.asString())));
+    }
+    stopTarget(truth);
+  }
+
+private:
+  Json::Value startTarget() {
+    target = popen("exec " SYNTHETIC_TARGET " --size_mb=4 --mappings=4 --values=50 --interval=1000 --truth=-", "r");
+    TS_ASSERT(target);
+
+    // The target keeps running, so read the JSON until its closing brace
+    string json;
+    char line[1024];
+    while (target && fgets(line, sizeof(line), target)) {
+      json += line;
+      if (line[0] == '}') {
+        break;
+      }
+    }
+    Json::Value truth;
+    Json::CharReaderBuilder builder;
+    string errors;
+    istringstream stream(json);
+    TS_ASSERT(Json::parseFromStream(builder, stream, &truth, &errors));
+    return truth;
+  }
+
+  void stopTarget(const Json::Value& truth) {
+    if (truth["pid"].asInt() > 0) {
+      kill(truth["pid"].asInt(), SIGKILL);
+    }
+    if (target) {
+      pclose(target);
+      target = NULL;
+    }
+  }
+
+  FILE* target = NULL; // stdout of the target
+};
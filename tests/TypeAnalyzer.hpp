@@ -0,0 +1,61 @@
+#include <cstring>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/TypeAnalyzer.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+class TestTypeAnalyzer : public CxxTest::TestSuite {
+public:
+  template<typename T>
+  uint64_t toSample(T value) {
+    uint64_t sample = 0;
+    memcpy(&sample, &value, sizeof(value));
+    return sample;
+  }
+
+  void testClassify() {
+    Maps maps;
+    maps.push(AddressPair(0x10000, 0x20000));
+    maps.sort();
+
+    vector<uint64_t> ints = { toSample<int32_t>(100), toSample<int32_t>(99), toSample<int32_t>(97) };
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify(ints, maps).kind, "int");
+
+    vector<uint64_t> floats = { toSample<float>(1.5), toSample<float>(1.75), toSample<float>(1.6) };
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify(floats, maps).scanType, SCAN_TYPE_FLOAT_32);
+
+    vector<uint64_t> doubles = { toSample<double>(100.0), toSample<double>(250.0) };
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify(doubles, maps).kind, "double");
+
+    vector<uint64_t> pointers = { 0x10010, 0x10020 };
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify(pointers, maps).kind, "pointer");
+
+    vector<uint64_t> bools = { 0, 1, 1, 0 };
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify(bools, maps).kind, "bool");
+
+    uint64_t text;
+    memcpy(&text, "hello\0\0", sizeof(text));
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify({ text }, maps).kind, "string");
+
+    TS_ASSERT_EQUALS(TypeAnalyzer::classify({ 0, 0 }, maps).kind, "unknown");
+  }
+
+  void testSample() {
+    uint64_t memory[2] = { toSample<float>(2.5), 42 };
+    MemIO memio;
+    memio.setPid(getpid());
+    TypeAnalyzer analyzer(&memio);
+    analyzer.setAddresses({ (Address)&memory[0], (Address)&memory[1] });
+    analyzer.sample();
+    memory[0] = toSample<float>(3.5);
+    analyzer.sample();
+
+    auto guesses = analyzer.classify();
+    TS_ASSERT_EQUALS(analyzer.getNumOfSamples(), 2);
+    TS_ASSERT_EQUALS(guesses[0].kind, "float");
+    TS_ASSERT_EQUALS(guesses[1].kind, "int");
+  }
+};
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/ValueCache.hpp"
+#include "mem/MemIO.hpp"
+
+using namespace std;
+
+class TestValueCache : public CxxTest::TestSuite {
+public:
+  void testUpdate() {
+    int memory[] = {100, 200, 300};
+    MemIO memio;
+    ValueCache cache(&memio);
+    cache.setRequests("scan", {
+        ValueRequest { 0, (Address)&memory[0], 4, "int32" },
+        ValueRequest { 5, (Address)&memory[2], 4, "int32" }
+      });
+    cache.setRequests("store", { ValueRequest { 1, (Address)&memory[1], 4, "int32" } });
+    TS_ASSERT_EQUALS(cache.getValues("scan").size(), 0);
+
+    cache.update();
+    auto values = cache.getValues("scan");
+    TS_ASSERT_EQUALS(values.size(), 2);
+    TS_ASSERT_EQUALS(values[0].value, "100");
+    TS_ASSERT_EQUALS(values[1].row, 5);
+    TS_ASSERT_EQUALS(values[1].value, "300");
+
+    auto store = cache.getValues("store");
+    TS_ASSERT_EQUALS(store.size(), 1);
+    TS_ASSERT_EQUALS(store[0].row, 1);
+    TS_ASSERT_EQUALS(store[0].value, "200");
+
+    memory[0] = 101;
+    TS_ASSERT_EQUALS(cache.getValues("scan")[0].value, "100");
+    cache.update();
+    TS_ASSERT_EQUALS(cache.getValues("scan")[0].value, "101");
+  }
+
+  void testWorker() {
+    int memory[] = {100};
+    MemIO memio;
+    ValueCache cache(&memio);
+    std::atomic<int> updates(0);
+    cache.setCallback([&]() { updates++; });
+    cache.setInterval(10000);
+    cache.setRequests("scan", { ValueRequest { 0, (Address)memory, 4, "int32" } });
+    cache.start();
+
+    memory[0] = 7;
+    int before = updates;
+    cache.refresh();
+    for (int i = 0; i < 200 && updates <= before; i++) {
+      std::this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    cache.stop();
+    TS_ASSERT(updates > before);
+    TS_ASSERT_EQUALS(cache.getValues("scan")[0].value, "7");
+  }
+
+  void testTwoProcesses() {
+    int memory[] = {100};
+    pid_t child = fork();
+    if (child == 0) {
+      pause();
+      _exit(0);
+    }
+    memory[0] = 200; // The child keeps 100
+
+    MemIO memio;
+    MemIO childMemIO;
+    childMemIO.setPid(child);
+    ValueCache cache(&memio);
+    cache.setRequests("store", {
+        ValueRequest { 0, (Address)memory, 4, "int32", NULL },
+        ValueRequest { 1, (Address)memory, 4, "int32", &childMemIO },
+        ValueRequest { 2, (Address)memory, 4, "int32", &memio }
+      });
+    cache.update();
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+
+    auto values = cache.getValues("store");
+    TS_ASSERT_EQUALS(values.size(), 3);
+    TS_ASSERT_EQUALS(values[0].value, "200");
+    TS_ASSERT_EQUALS(values[1].row, 1);
+    TS_ASSERT_EQUALS(values[1].value, "100");
+    TS_ASSERT_EQUALS(values[2].value, "200");
+  }
+};
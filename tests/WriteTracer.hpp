@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cxxtest/TestSuite.h>
+
+#include "mem/WriteTracer.hpp"
+
+using namespace std;
+
+namespace {
+  volatile int64_t tracedValue = 0;
+
+  // Each thread writes by its own instruction, so that the hits tell the threads apart
+  __attribute__((noinline)) void writeByMain() {
+    while (true) {
+      tracedValue = tracedValue + 1;
+      usleep(1000);
+    }
+  }
+
+  __attribute__((noinline)) void writeByThread() {
+    while (true) {
+      tracedValue = tracedValue + 2;
+      usleep(1000);
+    }
+  }
+
+  void onUser2(int) {}
+}
+
+class TestWriteTracer : public CxxTest::TestSuite {
+public:
+  void testHits() {
+    if (!WriteTracer::isSupported()) {
+      return;
+    }
+    pid_t child = fork();
+    if (child == 0) {
+      // The thread is created after the tracer is attached, so it is traced by the clone
+      usleep(50000);
+      std::thread other(writeByThread);
+      writeByMain();
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onUser2;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR2, &action, NULL);
+
+    WriteTracer tracer(child);
+    tracer.start((Address)&tracedValue, sizeof(tracedValue));
+    TS_ASSERT(tracer.isRunning());
+    this_thread::sleep_for(chrono::milliseconds(200));
+    tracer.stop();
+    TS_ASSERT(!tracer.isRunning());
+
+    vector<WriteHit> hits = tracer.getHits();
+    kill(child, SIGKILL);
+    waitpid(child, NULL, 0);
+
+    TS_ASSERT_EQUALS(hits.size(), 2);
+    for (auto& hit : hits) {
+      TS_ASSERT(hit.count > 10);
+      TS_ASSERT(hit.location.length() > 0);
+    }
+
+    // The handler of the application is restored
+    struct sigaction current;
+    sigaction(SIGUSR2, NULL, &current);
+    TS_ASSERT(current.sa_handler == onUser2);
+    signal(SIGUSR2, SIG_DFL);
+  }
+};